@@ -0,0 +1,349 @@
+/*
+ * Benchmark driver for the five mini-projects
+ * -------------------------------------------
+ * Runs deterministic synthetic workloads against the library cores
+ * (no menus, no user input) and prints one JSON document on stdout with
+ * throughput, p50/p99 per-operation latency and peak RSS.
+ *
+ * Usage: bench [operations-per-workload] [workload-name-filter]
+ *   defaults: 1000000 operations, all workloads
+ *
+ * Latency is sampled per batch of operations (two clock reads per batch)
+ * and divided by the batch size, so cheap operations such as push/pop are
+ * not swamped by timer overhead. Heavy operations use small batches.
+ * Each workload's peak_rss_kb is the process RSS high-water mark while that
+ * workload ran: the kernel's mark (VmHWM) is reset before every workload
+ * via /proc/self/clear_refs. Where that is unsupported the field is null;
+ * the top-level peak_rss_kb always covers the whole run.
+ * In an INSTRUMENT build the counters and spans gathered over the whole run
+ * are added under "instrumentation" (and they inflate the timings).
+ */
+#define _POSIX_C_SOURCE 200809L   // for clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <sys/resource.h>   // for getrusage() (peak RSS)
+#include "library.h"
+#include "stats.h"
+#include "stack.h"
+#include "calculator.h"
+#include "bst.h"
+#include "instrument.h"
+
+/* ----- WORKLOAD INTERFACE ----- */
+typedef struct {
+    const char* name;
+    int batch;                          // operations per latency sample
+    void (*setup)(long ops);            // untimed preparation
+    void (*run)(long first, int count); // performs operations first..first+count-1
+    void (*teardown)(void);             // untimed cleanup
+} Workload;
+
+static volatile long sink;  // keeps results alive so loops are not optimised out
+
+/* Deterministic xorshift64 generator: same workload on every run */
+static uint64_t rngState;
+static void seedRandom(uint64_t seed) { rngState = seed; }
+static uint64_t nextRandom(void) {
+    uint64_t x = rngState;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return rngState = x;
+}
+
+static uint64_t nowNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Permutation of 0..n-1 in a fixed pseudo-random order */
+static int* shuffledKeys(long n) {
+    int* keys = (int*)checkedMalloc((size_t)n * sizeof(int));
+    for (long i = 0; i < n; i++) keys[i] = (int)i;
+    for (long i = n - 1; i > 0; i--) {
+        long j = (long)(nextRandom() % (uint64_t)(i + 1));
+        int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+    }
+    return keys;
+}
+
+/* ----- LIBRARY CATALOG (prgm1) ----- */
+#define TITLE_POOL 256
+
+static Book books[MAX_BOOKS];
+static int bookCount;
+static char titles[TITLE_POOL][TITLE_LEN];
+
+static void setupCatalog(long ops) {
+    (void)ops;
+    for (int i = 0; i < TITLE_POOL; i++) {
+        snprintf(titles[i], TITLE_LEN, "Synthetic Title %03d", i);
+    }
+    bookCount = 0;
+    for (int i = 0; i < MAX_BOOKS; i++) {  // titles 0..99 are stored, 100+ miss
+        storeBook(books, &bookCount, titles[i], "Bench Author", "978-0000000000");
+    }
+}
+
+static void runStoreBook(long first, int count) {
+    for (long i = first; i < first + count; i++) {
+        if (bookCount == MAX_BOOKS) bookCount = 0;  // recycle the full catalog
+        storeBook(books, &bookCount, titles[i % TITLE_POOL], "Bench Author", "978-0000000000");
+    }
+}
+
+static void runFindBook(long first, int count) {
+    long found = 0;
+    for (int i = 0; i < count; i++) {
+        // Titles 0..199: half hit (scan to the match), half miss (full scan)
+        found += findBook(books, MAX_BOOKS, titles[nextRandom() % (2 * MAX_BOOKS)]);
+    }
+    sink = found + first;
+}
+
+/* ----- STATISTICS KERNELS (prgm2) ----- */
+static int numbers[MAX_NUMBERS];
+
+static void setupStats(long ops) {
+    (void)ops;
+    for (int i = 0; i < MAX_NUMBERS; i++) {
+        numbers[i] = (int)(nextRandom() % 2001) - 1000;
+    }
+}
+
+static void runStats(long first, int count) {
+    double acc = 0.0;
+    for (int i = 0; i < count; i++) {
+        numbers[(first + i) % MAX_NUMBERS]++;  // vary the input slightly
+        double mean = calculateMean(numbers, MAX_NUMBERS);
+        acc += calculateStdDev(numbers, MAX_NUMBERS, mean);
+    }
+    sink = (long)acc;
+}
+
+/* ----- STACK (prgm3) ----- */
+static Stack* stack;
+
+static void setupStack(long ops) {
+    (void)ops;
+    stack = createStack(1024);
+}
+
+static void runStack(long first, int count) {
+    int item;
+    long moved = 0;
+    for (int i = 0; i < count; i++) {
+        // Random push/pop mix; overflow and underflow paths are exercised too
+        if (nextRandom() & 1) moved += stackPush(stack, (int)(first + i));
+        else moved += stackPop(stack, &item);
+    }
+    sink = moved;
+}
+
+static void teardownStack(void) {
+    freeStack(stack);
+    stack = NULL;
+}
+
+/* ----- COMMAND DISPATCH (prgm4) ----- */
+static Command commands[4] = {
+    {add, undoAdd}, {subtract, undoSubtract},
+    {multiply, undoMultiply}, {divide, undoDivide}
+};
+static Calculator calc;
+
+static void setupCalculator(long ops) {
+    (void)ops;
+    calc = (Calculator){0, NULL, 0};
+}
+
+static void runCalculator(long first, int count) {
+    (void)first;
+    for (int i = 0; i < count; i++) {
+        uint64_t r = nextRandom();
+        int b = (int)((r >> 2) % 100) + 1;  // never zero: keeps results meaningful
+        runCommand(&calc, &commands[r & 3], (int)((r >> 16) % 10000), b);
+    }
+    sink = calc.currentResult;
+}
+
+/* ----- BINARY SEARCH TREE (prgm5) ----- */
+static Node* root;
+static int* keys;
+static long keyCount;
+
+static void setupTreeInsert(long ops) {
+    keyCount = ops;
+    keys = shuffledKeys(ops);
+    root = NULL;
+}
+
+static void setupTreeFull(long ops) {
+    setupTreeInsert(ops);
+    int* sorted = (int*)checkedMalloc((size_t)ops * sizeof(int));
+    for (long i = 0; i < ops; i++) sorted[i] = (int)i;
+    root = bulkLoad(sorted, (int)ops);
+    free(sorted);
+}
+
+static void setupTreeSorted(long ops) {
+    keyCount = ops;
+    keys = (int*)checkedMalloc((size_t)ops * sizeof(int));
+    for (long i = 0; i < ops; i++) keys[i] = (int)i;
+    root = NULL;
+}
+
+static void runTreeInsert(long first, int count) {
+    for (long i = first; i < first + count; i++) root = insert(root, keys[i]);
+}
+
+static void runTreeSearch(long first, int count) {
+    long found = 0;
+    for (int i = 0; i < count; i++) {
+        // Keys 0..2n-1: half hit, half miss
+        found += search(root, (int)(nextRandom() % (uint64_t)(2 * keyCount))) != NULL;
+    }
+    sink = found + first;
+}
+
+static void runTreeDelete(long first, int count) {
+    for (long i = first; i < first + count; i++) root = deleteNode(root, keys[i]);
+}
+
+static void runTreeBulkLoad(long first, int count) {
+    freeTree(root);  // only non-NULL if called more than once
+    root = bulkLoad(keys + first, count);
+}
+
+static void teardownTree(void) {
+    freeTree(root);
+    root = NULL;
+    free(keys);
+    keys = NULL;
+}
+
+/* ----- DRIVER ----- */
+static const Workload workloads[] = {
+    {"library_store_book",  64, setupCatalog,    runStoreBook,    NULL},
+    {"library_find_book",   16, setupCatalog,    runFindBook,     NULL},
+    {"stats_mean_stddev",   16, setupStats,      runStats,        NULL},
+    {"stack_push_pop",     256, setupStack,      runStack,        teardownStack},
+    {"calculator_execute", 256, setupCalculator, runCalculator,   NULL},
+    {"bst_insert",           1, setupTreeInsert, runTreeInsert,   teardownTree},
+    {"bst_search",           1, setupTreeFull,   runTreeSearch,   teardownTree},
+    {"bst_delete",           1, setupTreeFull,   runTreeDelete,   teardownTree},
+    {"bst_bulk_load",        0, setupTreeSorted, runTreeBulkLoad, teardownTree},  // 0: one batch
+};
+
+static int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* ----- PEAK RSS ----- */
+static long processPeakKb;  // whole-run peak, kept here since resets lower ru_maxrss
+
+static void notePeak(long kb) {
+    if (kb > processPeakKb) processPeakKb = kb;
+}
+
+static long maxRssKb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss;  // kilobytes on Linux
+}
+
+/* Resets the RSS high-water mark to the current RSS (Linux 4.0+).
+ * Returns false if the kernel does not support it. */
+static bool resetPeakRss(void) {
+    notePeak(maxRssKb());  // keep the whole-run peak before it is lost
+    FILE* fp = fopen("/proc/self/clear_refs", "w");
+    if (!fp) return false;
+    bool ok = fputs("5", fp) >= 0;
+    if (fclose(fp) != 0) ok = false;
+    return ok;
+}
+
+/* RSS high-water mark since the last reset (VmHWM), or -1 if unavailable */
+static long peakRssSinceResetKb(void) {
+    FILE* fp = fopen("/proc/self/status", "r");
+    if (!fp) return -1;
+    char line[256];
+    long kb = -1;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+    }
+    fclose(fp);
+    return kb;
+}
+
+/* Runs one workload and prints its JSON object */
+static void runWorkload(const Workload* w, long ops, int first) {
+    int batch = w->batch > 0 ? w->batch : (int)ops;
+    long samples = (ops + batch - 1) / batch;
+    double* latency = (double*)checkedMalloc((size_t)samples * sizeof(double));
+
+    bool peakReset = resetPeakRss();
+    seedRandom(0x9E3779B97F4A7C15ull);  // each workload sees the same stream
+    if (w->setup) w->setup(ops);
+
+    uint64_t start = nowNanos();
+    for (long s = 0; s < samples; s++) {
+        long begin = s * batch;
+        int count = (int)(ops - begin < batch ? ops - begin : batch);
+        uint64_t t0 = nowNanos();
+        w->run(begin, count);
+        latency[s] = (double)(nowNanos() - t0) / count;
+    }
+    double seconds = (double)(nowNanos() - start) / 1e9;
+
+    long peakKb = peakReset ? peakRssSinceResetKb() : -1;
+    notePeak(peakKb);
+    if (w->teardown) w->teardown();
+
+    qsort(latency, samples, sizeof(double), compareDoubles);
+    double p50 = latency[samples * 50 / 100];
+    double p99 = latency[samples * 99 / 100];
+    free(latency);
+
+    char peak[32];
+    if (peakKb >= 0) snprintf(peak, sizeof(peak), "%ld", peakKb);
+    else strcpy(peak, "null");
+
+    printf("%s    {\"name\": \"%s\", \"operations\": %ld, \"batch\": %d, "
+           "\"seconds\": %.6f, \"ops_per_sec\": %.1f, "
+           "\"p50_ns\": %.1f, \"p99_ns\": %.1f, \"peak_rss_kb\": %s}",
+           first ? "" : ",\n", w->name, ops, batch, seconds,
+           seconds > 0 ? ops / seconds : 0.0, p50, p99, peak);
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    long ops = 1000000;
+    const char* filter = argc > 2 ? argv[2] : NULL;
+
+    if (argc > 1) {
+        char* end;
+        ops = strtol(argv[1], &end, 10);
+        if (*end != '\0' || ops <= 0 || ops > 100000000) {
+            fprintf(stderr, "Error: operations must be between 1 and 100000000.\n");
+            return 1;
+        }
+    }
+
+    printf("{\n  \"operations\": %ld,\n  \"workloads\": [\n", ops);
+    int first = 1;
+    for (size_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+        if (filter && strstr(workloads[i].name, filter) == NULL) continue;
+        runWorkload(&workloads[i], ops, first);
+        first = 0;
+    }
+    notePeak(maxRssKb());
+    printf("\n  ],\n  \"peak_rss_kb\": %ld,\n  \"instrumentation\": ", processPeakKb);
+    instrDump(stdout);
+    printf("}\n");
+    return 0;
+}
@@ -0,0 +1,831 @@
+/*
+ * Binary Search Tree implementation (see bst.h).
+ * Error handling follows prgm5.c: allocation failures terminate the
+ * program, invalid operations print a message and leave the tree intact.
+ */
+#define _POSIX_C_SOURCE 200809L   // for fsync(), pthreads
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>     // for memcpy(), memcmp()
+#include <limits.h>     // for INT_MAX
+#include <errno.h>      // for ENOENT
+#include <unistd.h>     // for fsync(), close()
+#include <fcntl.h>      // for open()
+#include <sys/mman.h>   // for mmap() of snapshot and log files
+#include <sys/stat.h>   // for fstat()
+#include "bst.h"
+#include "instrument.h"
+
+/* ----- CREATE NEW NODE ----- */
+Node* createNode(int value) {
+    Node* newNode = (Node*)malloc(sizeof(Node));
+    if (!newNode) {  // defensive check: memory allocation
+        printf("Error: Memory allocation failed.\n");
+        exit(1);
+    }
+    newNode->data = value;
+    newNode->left = newNode->right = NULL;
+    return newNode;
+}
+
+/* ----- INSERT INTO BST ----- */
+/* Recursive part of insert(); the public function only adds the timing span.
+ * Duplicates are counted in *duplicates if given, else reported one by one. */
+static Node* insertInto(Node* root, int value, int* duplicates) {
+    if (root == NULL) {
+        return createNode(value);  // base case
+    }
+    if (value < root->data) {
+        root->left = insertInto(root->left, value, duplicates);
+    } else if (value > root->data) {
+        root->right = insertInto(root->right, value, duplicates);
+    } else {
+        INSTR_COUNT(BST_INSERT_DUPLICATES, 1);
+        if (duplicates) (*duplicates)++;
+        else printf("Warning: Duplicate value %d ignored.\n", value);//defensive programming
+    }
+    return root;
+}
+
+Node* insert(Node* root, int value) {
+    INSTR_SPAN_BEGIN(BST_INSERT);
+    root = insertInto(root, value, NULL);
+    INSTR_SPAN_END(BST_INSERT);
+    return root;
+}
+
+/* ----- SEARCH IN BST ----- */
+/* Records how deep a search went (nodes visited); no-op when not instrumented */
+static inline void recordSearchDepth(int depth) {
+    (void)depth;
+    INSTR_COUNT(BST_SEARCH_NODES_VISITED, depth);
+    INSTR_MAX(BST_SEARCH_DEPTH_MAX, depth);
+}
+
+/* Recursive part of search(); depth = nodes visited before this one */
+static Node* searchFrom(Node* root, int value, int depth) {
+    if (root == NULL) {
+        recordSearchDepth(depth);
+        INSTR_COUNT(BST_SEARCH_MISSES, 1);
+        return NULL;  // not found
+    }
+    if (root->data == value) {
+        recordSearchDepth(depth + 1);
+        return root;
+    } else if (value < root->data) {
+        return searchFrom(root->left, value, depth + 1);
+    } else {
+        return searchFrom(root->right, value, depth + 1);
+    }
+}
+
+Node* search(Node* root, int value) {
+    INSTR_SPAN_BEGIN(BST_SEARCH);
+    Node* found = searchFrom(root, value, 0);
+    INSTR_SPAN_END(BST_SEARCH);
+    return found;
+}
+
+/* ----- FIND MINIMUM NODE (Helper for deletion) ----- */
+Node* findMin(Node* root) {
+    while (root && root->left != NULL) {
+        root = root->left;
+    }
+    return root;
+}
+
+/* ----- DELETE NODE FROM BST ----- */
+/* Recursive part of deleteNode(); the public function only adds the timing span.
+ * Misses are counted in *misses if given, else reported one by one. */
+static Node* deleteFrom(Node* root, int value, int* misses) {
+    if (root == NULL) {
+        INSTR_COUNT(BST_DELETE_MISSES, 1);
+        if (misses) (*misses)++;
+        else printf("Error: Cannot delete %d (not found).\n", value);
+        return root;
+    }
+
+    if (value < root->data) {
+        root->left = deleteFrom(root->left, value, misses);
+    } else if (value > root->data) {
+        root->right = deleteFrom(root->right, value, misses);
+    } else {
+        // Found the node to delete
+        if (root->left == NULL && root->right == NULL) {
+            free(root);
+            return NULL;  // leaf node
+        } else if (root->left == NULL) {
+            Node* temp = root->right;
+            free(root);
+            return temp;
+        } else if (root->right == NULL) {
+            Node* temp = root->left;
+            free(root);
+            return temp;
+        } else {
+            Node* temp = findMin(root->right);  // inorder successor
+            root->data = temp->data;
+            root->right = deleteFrom(root->right, temp->data, misses);
+        }
+    }
+    return root;
+}
+
+Node* deleteNode(Node* root, int value) {
+    INSTR_SPAN_BEGIN(BST_DELETE);
+    root = deleteFrom(root, value, NULL);
+    INSTR_SPAN_END(BST_DELETE);
+    return root;
+}
+
+/* ----- INORDER TRAVERSAL (sorted order) ----- */
+void inorder(Node* root) {
+    if (root != NULL) {
+        inorder(root->left);
+        printf("%d ", root->data);
+        inorder(root->right);
+    }
+}
+
+/* ----- FREE WHOLE TREE ----- */
+void freeTree(Node* root) {
+    if (root != NULL) {
+        freeTree(root->left);
+        freeTree(root->right);
+        free(root);
+    }
+}
+
+/* ----- COUNT NODES ----- */
+int countNodes(Node* root) {
+    if (root == NULL) return 0;
+    return 1 + countNodes(root->left) + countNodes(root->right);
+}
+
+/* ----- BULK OPERATION HELPERS ----- */
+
+/* qsort comparator for ints (avoids overflow of a - b) */
+static int compareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/* Allocation wrapper with the same defensive check as createNode() */
+void* checkedMalloc(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        printf("Error: Memory allocation failed.\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* Sorts values[] (only if needed) and removes duplicates in place.
+ * Returns the number of unique values left at the front of the array.
+ * Already-sorted input is detected in one O(n) pass and never re-sorted. */
+static int sortUnique(int values[], int count, int* duplicates) {
+    int sorted = 1;
+    for (int i = 1; i < count && sorted; i++) {
+        if (values[i - 1] > values[i]) sorted = 0;
+    }
+    if (!sorted) {
+        qsort(values, count, sizeof(int), compareInts);
+    }
+
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique > 0 && values[unique - 1] == values[i]) continue;
+        values[unique++] = values[i];
+    }
+    if (duplicates) *duplicates = count - unique;
+    return unique;
+}
+
+/* Stores the nodes of the tree into nodes[] in sorted (in-order) order */
+static void flatten(Node* root, Node* nodes[], int* index) {
+    if (root != NULL) {
+        flatten(root->left, nodes, index);
+        nodes[(*index)++] = root;
+        flatten(root->right, nodes, index);
+    }
+}
+
+/* Relinks the sorted nodes[lo..hi] into a perfectly balanced tree.
+ * Each node is visited once, so this is O(n) and recurses only log2(n) deep. */
+static Node* linkBalanced(Node* nodes[], int lo, int hi) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    Node* root = nodes[mid];
+    root->left = linkBalanced(nodes, lo, mid - 1);
+    root->right = linkBalanced(nodes, mid + 1, hi);
+    return root;
+}
+
+/* Same as linkBalanced() but allocates the nodes from sorted values */
+static Node* buildBalanced(const int sorted[], int lo, int hi) {
+    if (lo > hi) return NULL;
+    int mid = lo + (hi - lo) / 2;
+    Node* root = createNode(sorted[mid]);
+    root->left = buildBalanced(sorted, lo, mid - 1);
+    root->right = buildBalanced(sorted, mid + 1, hi);
+    return root;
+}
+
+/* ----- BULK LOAD FROM SORTED ARRAY ----- */
+/* Builds a new balanced tree in O(n) from sorted input.
+ * Unsorted input is still accepted: it is sorted silently first, which
+ * costs O(n log n). Duplicates are dropped with a single warning, where
+ * insert() would warn once per value. The caller's array is not modified. */
+Node* bulkLoad(int values[], int count) {
+    if (values == NULL || count <= 0) {
+        return NULL;  // nothing to load: empty tree
+    }
+
+    int* sorted = (int*)checkedMalloc((size_t)count * sizeof(int));
+    memcpy(sorted, values, (size_t)count * sizeof(int));
+
+    int duplicates = 0;
+    int unique = sortUnique(sorted, count, &duplicates);
+    if (duplicates > 0) {
+        printf("Warning: %d duplicate value(s) ignored.\n", duplicates);
+    }
+
+    Node* root = buildBalanced(sorted, 0, unique - 1);
+    free(sorted);
+    return root;
+}
+
+/* ----- BULK LOAD FROM FILE STREAM ----- */
+/* Reads whitespace-separated integers until EOF and bulk-loads them.
+ * Stops with an error on the first non-integer token. */
+Node* bulkLoadStream(FILE* fp) {
+    if (fp == NULL) {
+        printf("Error: Invalid input stream.\n");
+        return NULL;
+    }
+
+    int capacity = 1024, count = 0, value;
+    int* values = (int*)checkedMalloc((size_t)capacity * sizeof(int));
+    int status;
+    while ((status = fscanf(fp, "%d", &value)) == 1) {
+        if (count == capacity) {  // grow geometrically: amortised O(1) per value
+            capacity *= 2;
+            int* grown = (int*)realloc(values, (size_t)capacity * sizeof(int));
+            if (!grown) {
+                printf("Error: Memory allocation failed.\n");
+                free(values);
+                exit(1);
+            }
+            values = grown;
+        }
+        values[count++] = value;
+    }
+    if (status != EOF) {
+        printf("Error: Non-integer data in input; loaded first %d value(s).\n", count);
+    }
+
+    Node* root = bulkLoad(values, count);
+    free(values);
+    return root;
+}
+
+/* Merges sorted, duplicate-free values into the tree in one pass over its
+ * in-order node list and relinks everything into a balanced tree.
+ * Existing nodes are reused, so only the new values are allocated.
+ * Values already present are skipped and counted in *duplicates. */
+static Node* mergeInsert(Node* root, const int sorted[], int k, int* duplicates) {
+    int n = countNodes(root), index = 0;
+    Node** existing = (Node**)checkedMalloc((size_t)n * sizeof(Node*));
+    flatten(root, existing, &index);
+
+    Node** merged = (Node**)checkedMalloc(((size_t)n + k) * sizeof(Node*));
+    int i = 0, j = 0, m = 0;
+    while (i < n || j < k) {
+        if (j == k || (i < n && existing[i]->data < sorted[j])) {
+            merged[m++] = existing[i++];
+        } else if (i == n || sorted[j] < existing[i]->data) {
+            merged[m++] = createNode(sorted[j++]);
+        } else {  // value already in tree: keep the existing node
+            merged[m++] = existing[i++];
+            j++;
+            (*duplicates)++;
+        }
+    }
+
+    root = linkBalanced(merged, 0, m - 1);
+    free(existing);
+    free(merged);
+    return root;
+}
+
+/* Walks sorted, duplicate-free values alongside the in-order node list in
+ * one pass, freeing matching nodes; survivors are relinked into a balanced
+ * tree. The number of nodes freed is added to *deleted. */
+static Node* mergeDelete(Node* root, const int sorted[], int k, int* deleted) {
+    int n = countNodes(root), index = 0;
+    Node** nodes = (Node**)checkedMalloc((size_t)n * sizeof(Node*));
+    flatten(root, nodes, &index);
+
+    int j = 0, kept = 0;
+    for (int i = 0; i < n; i++) {
+        while (j < k && sorted[j] < nodes[i]->data) j++;  // values not in tree
+        if (j < k && sorted[j] == nodes[i]->data) {
+            free(nodes[i]);
+            (*deleted)++;
+            j++;
+        } else {
+            nodes[kept++] = nodes[i];  // compact survivors in place
+        }
+    }
+
+    root = linkBalanced(nodes, 0, kept - 1);
+    free(nodes);
+    return root;
+}
+
+/* Counts the nodes of the tree, stopping once "limit" have been seen */
+static int countUpTo(Node* root, int limit) {
+    if (root == NULL || limit <= 0) return 0;
+    int left = countUpTo(root->left, limit - 1);
+    return 1 + left + countUpTo(root->right, limit - 1 - left);
+}
+
+/* A merge touches all n nodes, k walks about k * log2(n): merge only when
+ * that is cheaper. Counting stops at 32k nodes (log2(n) < 32 always, so a
+ * bigger tree means walks), which keeps the decision O(k), not O(n). */
+static bool preferWalks(Node* root, int k) {
+    int n = countUpTo(root, k > INT_MAX / 32 ? INT_MAX : 32 * k);
+    int log2n = 0;
+    while (log2n < 31 && (1 << log2n) <= n) log2n++;
+    return (long long)k * log2n < n;
+}
+
+/* Adds sorted, duplicate-free values: k walks for a small batch, else one
+ * mergeInsert(), which also rebalances. Present values count in *duplicates. */
+static Node* applyInserts(Node* root, const int sorted[], int k, int* duplicates) {
+    if (!preferWalks(root, k)) return mergeInsert(root, sorted, k, duplicates);
+    for (int i = 0; i < k; i++) root = insertInto(root, sorted[i], duplicates);
+    return root;
+}
+
+/* Removes sorted, duplicate-free values, choosing like applyInserts().
+ * The number of nodes freed is added to *deleted. */
+static Node* applyDeletes(Node* root, const int sorted[], int k, int* deleted) {
+    if (!preferWalks(root, k)) return mergeDelete(root, sorted, k, deleted);
+    int misses = 0;
+    for (int i = 0; i < k; i++) root = deleteFrom(root, sorted[i], &misses);
+    *deleted += k - misses;
+    return root;
+}
+
+/* ----- BATCHED INSERT ----- */
+/* Sorts the batch (k values), then adds it with applyInserts(). Cost:
+ * O(k log k) plus the cheaper of k root-to-leaf walks, O(k log n) on a
+ * balanced tree, and one O(n + k) merge that leaves the tree balanced. */
+Node* insertBatch(Node* root, int values[], int count) {
+    if (values == NULL || count <= 0) {
+        return root;  // empty batch: nothing to do
+    }
+
+    int* batch = (int*)checkedMalloc((size_t)count * sizeof(int));
+    memcpy(batch, values, (size_t)count * sizeof(int));
+    int k = sortUnique(batch, count, NULL);
+
+    int duplicates = count - k;
+    root = applyInserts(root, batch, k, &duplicates);
+    if (duplicates > 0) {
+        printf("Warning: %d duplicate value(s) ignored.\n", duplicates);
+    }
+
+    free(batch);
+    return root;
+}
+
+/* ----- BATCHED DELETE ----- */
+/* Sorts the batch, then removes it with applyDeletes(); same cost as
+ * insertBatch(). */
+Node* deleteBatch(Node* root, int values[], int count) {
+    if (values == NULL || count <= 0) {
+        return root;  // empty batch: nothing to do
+    }
+    if (root == NULL) {
+        printf("Error: Cannot delete from an empty tree.\n");
+        return root;
+    }
+
+    int* batch = (int*)checkedMalloc((size_t)count * sizeof(int));
+    memcpy(batch, values, (size_t)count * sizeof(int));
+    int k = sortUnique(batch, count, NULL);
+
+    int deleted = 0;
+    root = applyDeletes(root, batch, k, &deleted);
+    if (deleted < k) {
+        printf("Warning: %d value(s) not found.\n", k - deleted);
+    }
+
+    free(batch);
+    return root;
+}
+
+/* ----- CONCURRENT BST ----- */
+
+/* Takes ownership of an existing tree (e.g. from bulkLoad()) */
+void concurrentInit(ConcurrentBST* tree, Node* root) {
+    atomic_init(&tree->root, root);
+    atomic_init(&tree->epoch, 1);
+    for (int i = 0; i < MAX_READERS; i++) {
+        atomic_init(&tree->readers[i].epoch, 0);
+    }
+    pthread_mutex_init(&tree->writeLock, NULL);
+    tree->retired = NULL;
+    tree->retiredCount = tree->retiredCapacity = 0;
+}
+
+/* Frees everything; no reader or writer may be active */
+void concurrentDestroy(ConcurrentBST* tree) {
+    freeTree(atomic_load(&tree->root));
+    for (int i = 0; i < tree->retiredCount; i++) {
+        free(tree->retired[i].node);
+    }
+    free(tree->retired);
+    pthread_mutex_destroy(&tree->writeLock);
+}
+
+/* Lock-free lookup. "reader" is the caller's slot (0..MAX_READERS-1);
+ * each concurrently running reader thread must use its own slot. */
+bool concurrentSearch(ConcurrentBST* tree, int reader, int value) {
+    if (reader < 0 || reader >= MAX_READERS) {
+        printf("Error: Reader slot %d out of range.\n", reader);
+        return false;
+    }
+    ReaderSlot* slot = &tree->readers[reader];
+
+    // Announce the epoch before reading the root (both seq_cst), so a writer
+    // that retires nodes after this point sees us and keeps them alive.
+    atomic_store(&slot->epoch, atomic_load(&tree->epoch));
+    Node* node = atomic_load(&tree->root);
+    while (node != NULL && node->data != value) {
+        node = (value < node->data) ? node->left : node->right;
+    }
+    atomic_store_explicit(&slot->epoch, 0, memory_order_release);
+    return node != NULL;
+}
+
+/* Queues a replaced node for freeing; caller holds writeLock */
+static void retireNode(ConcurrentBST* tree, Node* node) {
+    if (tree->retiredCount == tree->retiredCapacity) {
+        int capacity = tree->retiredCapacity ? tree->retiredCapacity * 2 : 64;
+        RetiredNode* grown = (RetiredNode*)realloc(tree->retired,
+                                                   (size_t)capacity * sizeof(RetiredNode));
+        if (!grown) {
+            printf("Error: Memory allocation failed.\n");
+            exit(1);
+        }
+        tree->retired = grown;
+        tree->retiredCapacity = capacity;
+    }
+    tree->retired[tree->retiredCount].node = node;
+    tree->retired[tree->retiredCount].epoch = atomic_load(&tree->epoch);
+    tree->retiredCount++;
+}
+
+/* Copy of a node with the same children */
+static Node* cloneNode(ConcurrentBST* tree, Node* node) {
+    Node* copy = createNode(node->data);
+    copy->left = node->left;
+    copy->right = node->right;
+    retireNode(tree, node);
+    return copy;
+}
+
+/* Path-copying insert; value is known to be absent */
+static Node* copyInsert(ConcurrentBST* tree, Node* node, int value) {
+    if (node == NULL) return createNode(value);
+    Node* copy = cloneNode(tree, node);
+    if (value < node->data) copy->left = copyInsert(tree, node->left, value);
+    else copy->right = copyInsert(tree, node->right, value);
+    return copy;
+}
+
+/* Path-copying removal of the minimum of a non-empty subtree */
+static Node* copyDeleteMin(ConcurrentBST* tree, Node* node) {
+    if (node->left == NULL) {
+        retireNode(tree, node);
+        return node->right;  // right subtree is shared, not copied
+    }
+    Node* copy = cloneNode(tree, node);
+    copy->left = copyDeleteMin(tree, node->left);
+    return copy;
+}
+
+/* Path-copying delete; value is known to be present */
+static Node* copyDelete(ConcurrentBST* tree, Node* node, int value) {
+    if (value != node->data) {
+        Node* copy = cloneNode(tree, node);
+        if (value < node->data) copy->left = copyDelete(tree, node->left, value);
+        else copy->right = copyDelete(tree, node->right, value);
+        return copy;
+    }
+    retireNode(tree, node);
+    if (node->left == NULL) return node->right;
+    if (node->right == NULL) return node->left;
+
+    // Two children: a fresh node takes the inorder successor's value
+    Node* replacement = createNode(findMin(node->right)->data);
+    replacement->left = node->left;
+    replacement->right = copyDeleteMin(tree, node->right);
+    return replacement;
+}
+
+/* Frees retired nodes that no active reader can still reach */
+static void reclaimRetired(ConcurrentBST* tree) {
+    unsigned long oldest = atomic_load(&tree->epoch);
+    for (int i = 0; i < MAX_READERS; i++) {
+        unsigned long e = atomic_load(&tree->readers[i].epoch);
+        if (e != 0 && e < oldest) oldest = e;
+    }
+    int kept = 0;
+    for (int i = 0; i < tree->retiredCount; i++) {
+        if (tree->retired[i].epoch < oldest) free(tree->retired[i].node);
+        else tree->retired[kept++] = tree->retired[i];
+    }
+    tree->retiredCount = kept;
+}
+
+/* Publishes a new root and ends the current epoch; caller holds writeLock */
+static void publishRoot(ConcurrentBST* tree, Node* root) {
+    atomic_store(&tree->root, root);
+    atomic_fetch_add(&tree->epoch, 1);
+    if (tree->retiredCount >= 256) {  // amortise the reader-slot scan
+        reclaimRetired(tree);
+    }
+}
+
+/* Returns false (and changes nothing) if the value is already present */
+bool concurrentInsert(ConcurrentBST* tree, int value) {
+    pthread_mutex_lock(&tree->writeLock);
+    Node* root = atomic_load(&tree->root);
+    bool absent = search(root, value) == NULL;
+    if (absent) {
+        publishRoot(tree, copyInsert(tree, root, value));
+    }
+    pthread_mutex_unlock(&tree->writeLock);
+    return absent;
+}
+
+/* Returns false (and changes nothing) if the value is not present */
+bool concurrentDelete(ConcurrentBST* tree, int value) {
+    pthread_mutex_lock(&tree->writeLock);
+    Node* root = atomic_load(&tree->root);
+    bool present = search(root, value) != NULL;
+    if (present) {
+        publishRoot(tree, copyDelete(tree, root, value));
+    }
+    pthread_mutex_unlock(&tree->writeLock);
+    return present;
+}
+
+/* ----- SNAPSHOT PERSISTENCE ----- */
+
+/* Writes the keys of the tree in sorted order */
+static bool writeKeys(Node* root, FILE* fp) {
+    if (root == NULL) return true;
+    int32_t key = root->data;
+    return writeKeys(root->left, fp)
+        && fwrite(&key, sizeof(key), 1, fp) == 1
+        && writeKeys(root->right, fp);
+}
+
+/* Saves the tree to "path" as the given generation (one more than the
+ * snapshot it replaces). The snapshot is written to a temporary file,
+ * flushed to disk and renamed over the old one, so a crash mid-save never
+ * leaves a torn snapshot behind. */
+bool saveSnapshot(Node* root, const char* path, uint64_t generation) {
+    char tmpPath[512];
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path) >= (int)sizeof(tmpPath)) {
+        printf("Error: Snapshot path too long.\n");
+        return false;
+    }
+    FILE* fp = fopen(tmpPath, "wb");
+    if (!fp) {
+        printf("Error: Cannot create %s.\n", tmpPath);
+        return false;
+    }
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.generation = generation;
+    header.count = (uint64_t)countNodes(root);
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+           && writeKeys(root, fp)
+           && fflush(fp) == 0
+           && fsync(fileno(fp)) == 0;
+    if (fclose(fp) != 0) ok = false;
+    if (!ok || rename(tmpPath, path) != 0) {
+        printf("Error: Failed to write snapshot %s.\n", path);
+        remove(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+/* Loads a snapshot through mmap and builds a balanced tree straight from
+ * the mapped key array into *root; its generation goes to *generation.
+ * Returns true with *root = NULL (empty tree) and generation 0 if the file
+ * does not exist. Returns false, with a message and *root = NULL, if the
+ * file exists but cannot be read or fails validation; the caller must then
+ * not overwrite it, since it may still hold the only copy of the data. */
+/* The mapped int32 keys are built into the int-keyed tree without a copy */
+_Static_assert(_Generic((int32_t)0, int: 1, default: 0),
+               "snapshot keys must be readable as int; convert them in loadSnapshot()");
+
+bool loadSnapshot(const char* path, Node** root, uint64_t* generation) {
+    *root = NULL;
+    *generation = 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT) return true;  // no snapshot yet: start empty
+        printf("Error: Cannot open snapshot %s.\n", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        printf("Error: Snapshot %s is truncated.\n", path);
+        close(fd);
+        return false;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping stays valid after close
+    if (map == MAP_FAILED) {
+        printf("Error: Cannot map snapshot %s.\n", path);
+        return false;
+    }
+
+    // Validate before trusting anything in the file
+    const SnapshotHeader* header = (const SnapshotHeader*)map;
+    const int32_t* keys = (const int32_t*)(header + 1);
+    size_t available = ((size_t)st.st_size - sizeof(SnapshotHeader)) / sizeof(int32_t);
+    bool ok = false;
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0
+        || header->version != SNAPSHOT_VERSION) {
+        printf("Error: %s is not a BST snapshot.\n", path);
+    } else if (header->count > available || header->count > INT32_MAX) {
+        printf("Error: Snapshot %s is truncated.\n", path);
+    } else {
+        int count = (int)header->count;
+        bool sorted = true;
+        for (int i = 1; i < count && sorted; i++) {
+            if (keys[i - 1] >= keys[i]) sorted = false;
+        }
+        if (!sorted) {
+            printf("Error: Snapshot %s is corrupt (keys out of order).\n", path);
+        } else {
+            *root = buildBalanced((const int*)keys, 0, count - 1);
+            *generation = header->generation;
+            ok = true;
+        }
+    }
+
+    munmap(map, (size_t)st.st_size);
+    return ok;
+}
+
+/* ----- OPERATION LOG ----- */
+
+/* Generation as stored in a LOG_GENERATION record. Only equality matters
+ * and a stale log is exactly one generation behind, so wrapping is fine. */
+static int32_t generationTag(uint64_t generation) {
+    return (int32_t)(generation % 2147483648u);
+}
+
+/* Opens the log that follows the snapshot of the given generation for
+ * appending. A log that already belongs to it is kept, minus a torn last
+ * record so new records stay aligned; any other content is from an older
+ * snapshot and is discarded, and the log restarts with a LOG_GENERATION
+ * record. Returns NULL if the file cannot be opened or truncated. */
+FILE* openLog(const char* path, uint64_t generation) {
+    int fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    LogRecord first;
+    bool current = fstat(fd, &st) == 0
+                && (size_t)st.st_size >= sizeof(LogRecord)
+                && pread(fd, &first, sizeof(first), 0) == (ssize_t)sizeof(first)
+                && first.op == LOG_GENERATION && first.value == generationTag(generation);
+    off_t keep = current ? st.st_size - st.st_size % (off_t)sizeof(LogRecord) : 0;
+
+    FILE* log = ftruncate(fd, keep) == 0 ? fdopen(fd, "ab") : NULL;
+    if (!log) {
+        close(fd);
+        return NULL;
+    }
+    if (!current) logOperation(log, LOG_GENERATION, generationTag(generation));
+    return log;
+}
+
+/* Appends one record; flushed immediately so it survives a crash of the
+ * program (not of the machine). Does nothing when logging is off. */
+void logOperation(FILE* log, char op, int value) {
+    if (log == NULL) return;
+    LogRecord record = {op, value};
+    if (fwrite(&record, sizeof(record), 1, log) != 1 || fflush(log) != 0) {
+        printf("Warning: Failed to log operation on %d.\n", value);
+    }
+}
+
+/* Orders log entries by value, then by position in the log */
+static int compareLogEntries(const void* a, const void* b) {
+    const int64_t* x = (const int64_t*)a;
+    const int64_t* y = (const int64_t*)b;
+    return (*x > *y) - (*x < *y);
+}
+
+/* Applies the log at "path" to the tree in *root, which was loaded from
+ * the snapshot of the given generation. For a set, only the last
+ * operation on each value matters, so the log is sorted by (value,
+ * position) and reduced to one delete batch and one insert batch, applied
+ * like insertBatch()/deleteBatch(). A log written for another generation
+ * predates the snapshot (whose tree may have been replaced since) and is
+ * skipped with a warning.
+ * Returns true if the log was applied, skipped or does not exist. Returns
+ * false, with a message and *root unchanged, if it exists but cannot be
+ * read or is not a log; as with loadSnapshot(), the caller must then not
+ * truncate it. */
+bool replayLog(const char* path, uint64_t generation, Node** root) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT) return true;  // no log: nothing happened since the snapshot
+        printf("Error: Cannot open log %s.\n", path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        printf("Error: Cannot read log %s.\n", path);
+        close(fd);
+        return false;
+    }
+    if ((size_t)st.st_size < sizeof(LogRecord)) {
+        close(fd);
+        return true;  // empty, or cut short while starting: no operations yet
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error: Cannot map log %s.\n", path);
+        return false;
+    }
+
+    const LogRecord* records = (const LogRecord*)map;
+    if (records[0].op != LOG_GENERATION) {
+        printf("Error: %s is not a BST operation log.\n", path);
+        munmap(map, (size_t)st.st_size);
+        return false;
+    }
+    if (records[0].value != generationTag(generation)) {
+        printf("Warning: Ignoring %s (written before the current snapshot).\n", path);
+        munmap(map, (size_t)st.st_size);
+        return true;
+    }
+    records++;  // operations follow the generation record
+    int count = (int)((size_t)st.st_size / sizeof(LogRecord)) - 1;  // ignores a torn tail
+
+    // Key = value in the high 32 bits, position in the low 32 bits
+    int64_t* entries = (int64_t*)checkedMalloc((size_t)count * sizeof(int64_t));
+    for (int i = 0; i < count; i++) {
+        entries[i] = (int64_t)records[i].value * 4294967296LL + i;
+    }
+    qsort(entries, count, sizeof(int64_t), compareLogEntries);
+
+    int* inserts = (int*)checkedMalloc((size_t)count * sizeof(int));
+    int* deletes = (int*)checkedMalloc((size_t)count * sizeof(int));
+    int insertCount = 0, deleteCount = 0, invalid = 0;
+    for (int i = 0; i < count; i++) {
+        int value = records[entries[i] & 0xFFFFFFFFLL].value;
+        if (i + 1 < count && records[entries[i + 1] & 0xFFFFFFFFLL].value == value) {
+            continue;  // a later operation on the same value wins
+        }
+        int32_t op = records[entries[i] & 0xFFFFFFFFLL].op;
+        if (op == 'I') inserts[insertCount++] = value;
+        else if (op == 'D') deletes[deleteCount++] = value;
+        else invalid++;
+    }
+    if (invalid > 0) {
+        printf("Warning: %d corrupt log record(s) skipped.\n", invalid);
+    }
+
+    // Both lists are sorted and unique; duplicates/misses are expected here
+    int ignored = 0;
+    *root = applyDeletes(*root, deletes, deleteCount, &ignored);
+    *root = applyInserts(*root, inserts, insertCount, &ignored);
+
+    free(entries);
+    free(inserts);
+    free(deletes);
+    munmap(map, (size_t)st.st_size);
+    return true;
+}
@@ -0,0 +1,110 @@
+/*
+ * Binary Search Tree (library part of prgm5.c)
+ * --------------------------------------------
+ * Features:
+ *   - Recursive insert/search/delete and in-order display
+ *   - O(n) bulk load and batched insert/delete
+ *   - Copy-on-write concurrent variant with lock-free lookups
+ *   - Binary snapshots (mmap reload) and an append-only operation log
+ */
+#ifndef BST_H
+#define BST_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* ----- BST NODE STRUCTURE ----- */
+typedef struct Node {
+    int data;
+    struct Node *left, *right;
+} Node;
+
+/* ----- CONCURRENT BST STRUCTURE ----- */
+/* Copy-on-write variant for many readers and one writer at a time.
+ * Published nodes are never modified: a writer copies the root-to-target
+ * path, then swaps in the new root atomically. Readers take no locks; they
+ * only announce the epoch they started in, so replaced nodes are freed
+ * once no reader from an older epoch can still be walking them. */
+#define MAX_READERS 64
+#define CACHE_LINE 64
+
+typedef struct {
+    // Aligned, and so padded, to a full cache line: no false sharing
+    _Alignas(CACHE_LINE) atomic_ulong epoch;  // epoch the reader started in (0 = not reading)
+} ReaderSlot;
+
+typedef struct {
+    Node* node;           // node unlinked by a writer
+    unsigned long epoch;  // epoch in which it was unlinked
+} RetiredNode;
+
+/* root and epoch share the first line (read by every lookup, written only
+ * by writers); each reader slot starts a line of its own after them.
+ * Keeping that layout needs the struct itself 64-byte aligned, so declare
+ * it as a variable or use aligned_alloc(), not plain malloc(). */
+typedef struct {
+    _Atomic(Node*) root;
+    atomic_ulong epoch;                  // global epoch, advanced per write
+    ReaderSlot readers[MAX_READERS];
+    pthread_mutex_t writeLock;           // serialises writers only
+    RetiredNode* retired;                // nodes waiting to be freed
+    int retiredCount, retiredCapacity;
+} ConcurrentBST;
+
+_Static_assert(sizeof(ReaderSlot) == CACHE_LINE, "reader slot must fill one cache line");
+_Static_assert(offsetof(ConcurrentBST, readers) == CACHE_LINE,
+               "reader slots must not share a line with root/epoch");
+
+/* ----- SNAPSHOT AND OPERATION LOG FORMAT ----- */
+/* Snapshot: header followed by "count" int32 keys in ascending order
+ * (native byte order), so a reload is an mmap plus an O(n) balanced build.
+ * Log: a LOG_GENERATION record naming the snapshot it follows, then
+ * fixed-size records appended for every insert/delete made since. Each
+ * snapshot gets the next generation, so a log left over from an older
+ * snapshot (crash between the rename and the log reset) is never replayed. */
+#define SNAPSHOT_MAGIC "BST1"
+#define SNAPSHOT_VERSION 2
+#define LOG_GENERATION 'G'
+
+typedef struct {
+    char magic[4];        // SNAPSHOT_MAGIC
+    uint32_t version;     // SNAPSHOT_VERSION
+    uint64_t generation;  // incremented by every save; 0 = no snapshot yet
+    uint64_t count;       // number of keys that follow
+} SnapshotHeader;
+
+typedef struct {
+    int32_t op;        // 'I' (insert), 'D' (delete) or LOG_GENERATION (first record)
+    int32_t value;     // the key, or the generation modulo 2^31
+} LogRecord;
+
+/* ----- FUNCTION DECLARATIONS ----- */
+Node* createNode(int value);
+Node* insert(Node* root, int value);
+Node* search(Node* root, int value);
+Node* deleteNode(Node* root, int value);
+Node* findMin(Node* root);
+void inorder(Node* root);
+void freeTree(Node* root);
+int countNodes(Node* root);
+void* checkedMalloc(size_t size);
+Node* bulkLoad(int values[], int count);
+Node* bulkLoadStream(FILE* fp);
+Node* insertBatch(Node* root, int values[], int count);
+Node* deleteBatch(Node* root, int values[], int count);
+void concurrentInit(ConcurrentBST* tree, Node* root);
+void concurrentDestroy(ConcurrentBST* tree);
+bool concurrentSearch(ConcurrentBST* tree, int reader, int value);
+bool concurrentInsert(ConcurrentBST* tree, int value);
+bool concurrentDelete(ConcurrentBST* tree, int value);
+bool saveSnapshot(Node* root, const char* path, uint64_t generation);
+bool loadSnapshot(const char* path, Node** root, uint64_t* generation);
+bool replayLog(const char* path, uint64_t generation, Node** root);
+FILE* openLog(const char* path, uint64_t generation);
+void logOperation(FILE* log, char op, int value);
+
+#endif /* BST_H */
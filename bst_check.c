@@ -0,0 +1,382 @@
+/*
+ * Non-interactive checks for the BST library (make check)
+ * -------------------------------------------------------
+ * Covers the parts that are easy to get subtly wrong:
+ *   - batched insert/delete keep the BST invariant and the right key set,
+ *     whether applied as walks (small batches) or as a merge
+ *   - copy-on-write readers never miss a present key while a writer churns
+ *   - snapshot + operation log round trip, including a crash between the
+ *     snapshot rename and the log reset, also after the tree was replaced
+ *   - damaged snapshots and unreadable logs are rejected, missing ones
+ *     mean "start empty"
+ *
+ * Exit status is the number of failed checks (0 = all passed).
+ * For sanitizer runs rebuild everything with the extra flags, e.g.
+ *   make check CFLAGS="-std=c11 -O1 -g -fsanitize=thread"
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>     // for unlink(), rmdir()
+#include <sys/stat.h>   // for mkdir()
+#include "bst.h"
+
+static int failures;
+
+#define CHECK(cond, ...) do {                                   \
+        if (!(cond)) {                                          \
+            failures++;                                         \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);         \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+/* Deterministic xorshift32 so failures reproduce */
+static unsigned int nextRandom(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return *state = x;
+}
+
+/* ----- HELPERS ----- */
+
+/* True if every key lies strictly between lo and hi (exclusive bounds) */
+static bool isBst(Node* root, long lo, long hi) {
+    if (root == NULL) return true;
+    if (root->data <= lo || root->data >= hi) return false;
+    return isBst(root->left, lo, root->data) && isBst(root->right, root->data, hi);
+}
+
+static int height(Node* root) {
+    if (root == NULL) return 0;
+    int l = height(root->left), r = height(root->right);
+    return 1 + (l > r ? l : r);
+}
+
+/* Compares the in-order keys of the tree with the set present[0..range-1] */
+static bool matchesSet(Node* root, const bool present[], int range) {
+    int expected = 0;
+    for (int v = 0; v < range; v++) expected += present[v];
+    if (countNodes(root) != expected) return false;
+    for (int v = 0; v < range; v++) {
+        if ((search(root, v) != NULL) != present[v]) return false;
+    }
+    return true;
+}
+
+/* ----- BATCHED INSERT / DELETE ----- */
+#define BATCH_RANGE 4096
+
+static void checkBatches(void) {
+    static bool present[BATCH_RANGE];
+    int values[64];
+    unsigned int rng = 12345;
+    Node* root = NULL;
+
+    for (int round = 0; round < 300; round++) {
+        bool inserting = (round % 3) != 2;  // grow on average
+        int k = (int)(nextRandom(&rng) % 64) + 1, n = 0;
+        for (int i = 0; i < k; i++) {
+            int v = (int)(nextRandom(&rng) % BATCH_RANGE);
+            // Only absent values for inserts and present ones for deletes, so
+            // this loop stays quiet; the warning paths are checked below.
+            if (present[v] == inserting) continue;
+            bool seen = false;
+            for (int j = 0; j < n; j++) seen |= values[j] == v;
+            if (!seen) values[n++] = v;
+        }
+        if (inserting) {
+            root = insertBatch(root, values, n);
+            for (int i = 0; i < n; i++) present[values[i]] = true;
+        } else if (root != NULL) {
+            root = deleteBatch(root, values, n);
+            for (int i = 0; i < n; i++) present[values[i]] = false;
+        }
+        CHECK(isBst(root, -1L, (long)BATCH_RANGE), "BST invariant broken after round %d", round);
+        CHECK(matchesSet(root, present, BATCH_RANGE), "wrong key set after round %d", round);
+    }
+
+    // Small batches above were applied as walks; one covering the rest of
+    // the range is large enough to merge, which rebuilds a balanced tree
+    static int rest[BATCH_RANGE];
+    int restCount = 0;
+    for (int v = 0; v < BATCH_RANGE; v++) {
+        if (!present[v]) rest[restCount++] = v;
+        present[v] = true;
+    }
+    root = insertBatch(root, rest, restCount);
+    CHECK(isBst(root, -1L, (long)BATCH_RANGE) && matchesSet(root, present, BATCH_RANGE),
+          "wrong tree after a large batch");
+    int n = countNodes(root), minHeight = 0;
+    while ((1 << minHeight) - 1 < n) minHeight++;
+    CHECK(height(root) == minHeight, "height %d, expected %d", height(root), minHeight);
+
+    // Duplicates and misses are ignored (with a warning each batch)
+    printf("(expected warnings follow)\n");
+    int first = -1;
+    for (int v = 0; v < BATCH_RANGE && first < 0; v++) if (present[v]) first = v;
+    int dup[] = {first, first};
+    root = insertBatch(root, dup, 2);
+    int miss[] = {-5, BATCH_RANGE + 5};
+    root = deleteBatch(root, miss, 2);
+    CHECK(matchesSet(root, present, BATCH_RANGE), "duplicates or misses changed the tree");
+
+    freeTree(root);
+    printf("check: batched insert/delete ... done\n");
+}
+
+/* ----- COPY-ON-WRITE CONCURRENT TREE ----- */
+#define COW_KEYS 20000      // even keys 0..2(COW_KEYS-1) are always present
+#define COW_READERS 4
+#define COW_WRITES 20000
+
+typedef struct {
+    ConcurrentBST* tree;
+    atomic_bool* running;
+    int reader;
+    long lookups, misses;
+} CowReader;
+
+static void* cowReader(void* arg) {
+    CowReader* r = (CowReader*)arg;
+    unsigned int rng = 777u + (unsigned)r->reader;
+    // Keep going until the writer is done, and at least a few thousand times
+    while (atomic_load(r->running) || r->lookups < 5000) {
+        int key = (int)(nextRandom(&rng) % COW_KEYS) * 2;
+        if (!concurrentSearch(r->tree, r->reader, key)) r->misses++;
+        r->lookups++;
+    }
+    return NULL;
+}
+
+static void checkConcurrent(void) {
+    int* even = (int*)checkedMalloc(COW_KEYS * sizeof(int));
+    for (int i = 0; i < COW_KEYS; i++) even[i] = 2 * i;
+    ConcurrentBST tree;
+    concurrentInit(&tree, bulkLoad(even, COW_KEYS));
+    free(even);
+
+    atomic_bool running;
+    atomic_init(&running, true);
+    pthread_t threads[COW_READERS];
+    CowReader readers[COW_READERS];
+    for (int i = 0; i < COW_READERS; i++) {
+        readers[i] = (CowReader){&tree, &running, i, 0, 0};
+        pthread_create(&threads[i], NULL, cowReader, &readers[i]);
+    }
+
+    // Writer: churn odd keys. Deleting an odd key with two children copies
+    // its successor's path, so even-key nodes are replaced all the time.
+    static bool odd[COW_KEYS];
+    unsigned int rng = 4242;
+    for (int i = 0; i < COW_WRITES; i++) {
+        int slot = (int)(nextRandom(&rng) % COW_KEYS);
+        int key = 2 * slot + 1;
+        if (nextRandom(&rng) & 1) {
+            CHECK(concurrentInsert(&tree, key) == !odd[slot], "insert %d result wrong", key);
+            odd[slot] = true;
+        } else {
+            CHECK(concurrentDelete(&tree, key) == odd[slot], "delete %d result wrong", key);
+            odd[slot] = false;
+        }
+    }
+    atomic_store(&running, false);
+
+    long lookups = 0, misses = 0;
+    for (int i = 0; i < COW_READERS; i++) {
+        pthread_join(threads[i], NULL);
+        lookups += readers[i].lookups;
+        misses += readers[i].misses;
+    }
+    CHECK(misses == 0, "%ld of %ld lookups missed a present key", misses, lookups);
+
+    // Final tree: every even key plus exactly the odd keys the writer left
+    Node* root = atomic_load(&tree.root);
+    CHECK(isBst(root, -1L, 2L * COW_KEYS), "BST invariant broken");
+    int expected = COW_KEYS;
+    for (int i = 0; i < COW_KEYS; i++) {
+        expected += odd[i];
+        CHECK(search(root, 2 * i) != NULL, "even key %d lost", 2 * i);
+        CHECK((search(root, 2 * i + 1) != NULL) == odd[i], "odd key %d wrong", 2 * i + 1);
+    }
+    CHECK(countNodes(root) == expected, "%d nodes, expected %d", countNodes(root), expected);
+
+    concurrentDestroy(&tree);
+    printf("check: copy-on-write readers (%ld lookups) ... done\n", lookups);
+}
+
+/* ----- SNAPSHOT AND OPERATION LOG ----- */
+#define SNAP_RANGE 2048
+
+static char snapDir[64], snapPath[128], logPath[128];
+
+/* Writes raw bytes to the snapshot path (for damaged-file checks) */
+static void writeRaw(const void* data, size_t size) {
+    FILE* fp = fopen(snapPath, "wb");
+    fwrite(data, 1, size, fp);
+    fclose(fp);
+}
+
+/* Loads the snapshot and replays the log, like prgm5's startup */
+static Node* restore(bool* ok) {
+    Node* root;
+    uint64_t generation;
+    *ok = loadSnapshot(snapPath, &root, &generation) && replayLog(logPath, generation, &root);
+    return root;
+}
+
+static void checkSnapshots(void) {
+    strcpy(snapDir, "/tmp/bst_check_XXXXXX");
+    if (mkdtemp(snapDir) == NULL) {
+        CHECK(false, "cannot create temporary directory");
+        return;
+    }
+    snprintf(snapPath, sizeof(snapPath), "%s/tree.snap", snapDir);
+    snprintf(logPath, sizeof(logPath), "%s/tree.snap.log", snapDir);
+
+    static bool present[SNAP_RANGE];
+    bool ok;
+    uint64_t generation;
+
+    // Missing snapshot and log: valid, empty tree
+    Node* root = restore(&ok);
+    CHECK(ok && root == NULL, "missing snapshot should load as an empty tree");
+
+    // Snapshot of every third key
+    int values[SNAP_RANGE], n = 0;
+    for (int v = 0; v < SNAP_RANGE; v += 3) {
+        values[n++] = v;
+        present[v] = true;
+    }
+    root = bulkLoad(values, n);
+    CHECK(saveSnapshot(root, snapPath, 1), "saveSnapshot failed");
+
+    // Random inserts and deletes after the snapshot, logged the way prgm5
+    // logs them; repeated ops on one value exercise last-op-wins
+    FILE* log = openLog(logPath, 1);
+    unsigned int rng = 99;
+    for (int i = 0; i < 3000; i++) {
+        int v = (int)(nextRandom(&rng) % SNAP_RANGE);
+        if (nextRandom(&rng) & 1) {
+            if (!present[v]) root = insertBatch(root, &v, 1);  // quiet insert
+            logOperation(log, 'I', v);
+            present[v] = true;
+        } else {
+            if (present[v]) root = deleteBatch(root, &v, 1);   // quiet delete
+            logOperation(log, 'D', v);
+            present[v] = false;
+        }
+    }
+    fclose(log);
+    CHECK(matchesSet(root, present, SNAP_RANGE), "reference tree out of sync");
+
+    Node* restored = restore(&ok);
+    CHECK(ok && isBst(restored, -1L, (long)SNAP_RANGE), "restored tree invalid");
+    CHECK(matchesSet(restored, present, SNAP_RANGE), "snapshot + log round trip lost data");
+    freeTree(restored);
+
+    // Crash after the new snapshot was renamed into place but before the
+    // log was reset: the old log is skipped
+    CHECK(saveSnapshot(root, snapPath, 2), "saveSnapshot failed");
+    restored = restore(&ok);
+    CHECK(ok && matchesSet(restored, present, SNAP_RANGE), "old log changed the newer snapshot");
+    freeTree(restored);
+
+    // Same crash after a bulk load replaced the tree: values inserted by the
+    // old log are not in the new snapshot and must not come back
+    int replacement[] = {SNAP_RANGE + 1, SNAP_RANGE + 2};
+    Node* replaced = bulkLoad(replacement, 2);
+    CHECK(saveSnapshot(replaced, snapPath, 3), "saveSnapshot failed");
+    restored = restore(&ok);
+    CHECK(ok && countNodes(restored) == 2, "old log replayed over a replaced tree");
+    freeTree(restored);
+
+    // Reopening resets the stale log; later reopens keep it but drop a torn
+    // last record, so appended records stay aligned
+    log = openLog(logPath, 3);
+    logOperation(log, 'I', 7);
+    fclose(log);
+    log = fopen(logPath, "ab");
+    fwrite("xyz", 1, 3, log);  // crash in the middle of a record
+    fclose(log);
+    log = openLog(logPath, 3);
+    logOperation(log, 'D', SNAP_RANGE + 1);
+    fclose(log);
+    restored = restore(&ok);
+    CHECK(ok && countNodes(restored) == 2 && search(restored, 7) && search(restored, SNAP_RANGE + 2),
+          "log reopen lost or misaligned records");
+    freeTree(restored);
+    freeTree(replaced);
+
+    // A file without a generation record is not a log: restore fails
+    log = fopen(logPath, "wb");
+    logOperation(log, 'I', 7);
+    fclose(log);
+    restored = restore(&ok);
+    CHECK(!ok, "log without a generation record accepted");
+    freeTree(restored);
+
+    // A log that exists but cannot be read fails the restore (a directory
+    // opens but cannot be mapped) instead of passing for an empty log
+    unlink(logPath);
+    mkdir(logPath, 0700);
+    restored = restore(&ok);
+    CHECK(!ok, "unreadable log accepted");
+    freeTree(restored);
+    rmdir(logPath);
+
+    // Damaged snapshots are rejected and leave *root empty
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.generation = 4;
+    header.count = 3;
+    struct { SnapshotHeader h; int32_t keys[3]; } file = {header, {1, 2, 3}};
+    size_t fileSize = sizeof(SnapshotHeader) + sizeof(file.keys);  // no padding
+
+    unlink(logPath);  // only the snapshot matters from here on
+    writeRaw(&file, fileSize);
+    restored = restore(&ok);
+    CHECK(ok && countNodes(restored) == 3, "valid hand-written snapshot rejected");
+    freeTree(restored);
+
+    writeRaw("BST", 3);                                  // shorter than a header
+    CHECK(!loadSnapshot(snapPath, &restored, &generation) && restored == NULL, "truncated header accepted");
+    file.h.magic[0] = 'X';                               // bad magic
+    writeRaw(&file, fileSize);
+    CHECK(!loadSnapshot(snapPath, &restored, &generation) && restored == NULL, "bad magic accepted");
+    file.h.magic[0] = SNAPSHOT_MAGIC[0];
+    file.h.version = SNAPSHOT_VERSION + 1;               // unknown version
+    writeRaw(&file, fileSize);
+    CHECK(!loadSnapshot(snapPath, &restored, &generation) && restored == NULL, "wrong version accepted");
+    file.h.version = SNAPSHOT_VERSION;
+    writeRaw(&file, fileSize - sizeof(int32_t));         // keys cut short
+    CHECK(!loadSnapshot(snapPath, &restored, &generation) && restored == NULL, "truncated keys accepted");
+    file.keys[1] = 7;                                    // keys out of order
+    writeRaw(&file, fileSize);
+    CHECK(!loadSnapshot(snapPath, &restored, &generation) && restored == NULL, "unsorted keys accepted");
+
+    freeTree(root);
+    unlink(snapPath);
+    unlink(logPath);
+    rmdir(snapDir);
+    printf("check: snapshot and operation log ... done\n");
+}
+
+int main(void) {
+    checkBatches();
+    checkConcurrent();
+    checkSnapshots();
+
+    if (failures > 0) {
+        printf("%d check(s) FAILED\n", failures);
+    } else {
+        printf("all checks passed\n");
+    }
+    return failures;
+}
@@ -0,0 +1,65 @@
+/*
+ * Calculator commands and invoker (see calculator.h)
+ * The commands and runCommand() never print; division by zero leaves the
+ * dividend unchanged and is reported by executeCommand().
+ */
+
+#include <stdio.h>
+#include "calculator.h"
+#include "instrument.h"
+
+/* ----- CONCRETE COMMANDS ----- */
+
+// ADDITION
+int add(int a, int b) { return a + b; }
+void undoAdd(int* result, int b) { *result -= b; } // reverse by subtracting
+
+// SUBTRACTION
+int subtract(int a, int b) { return a - b; }
+void undoSubtract(int* result, int b) { *result += b; } // reverse by adding
+
+// MULTIPLICATION
+int multiply(int a, int b) { return a * b; }
+void undoMultiply(int* result, int b) {
+    if (b != 0) *result /= b;  // reverse by dividing (if possible)
+}
+
+// DIVISION
+int divide(int a, int b) {
+    if (b == 0) {
+        INSTR_COUNT(COMMAND_DIVIDE_BY_ZERO, 1);
+        return a;  // return unchanged (executeCommand() reports the error)
+    }
+    return a / b;
+}
+void undoDivide(int* result, int b) { *result *= b; } // reverse by multiplying
+
+/* ----- INVOKER ----- */
+
+/* Executes chosen command without printing; returns the new result */
+int runCommand(Calculator* calc, Command* cmd, int a, int b) {
+    INSTR_SPAN_BEGIN(RUN_COMMAND);
+    calc->currentResult = cmd->execute(a, b);  // run operation
+    calc->lastCommand = cmd;                   // remember command
+    calc->lastOperand = b;                     // remember operand
+    INSTR_SPAN_END(RUN_COMMAND);
+    return calc->currentResult;
+}
+
+/* Executes chosen command and prints the result */
+void executeCommand(Calculator* calc, Command* cmd, int a, int b) {
+    if (cmd->execute == divide && b == 0) {
+        printf("Error: Division by zero!\n");
+    }
+    printf("Result: %d\n", runCommand(calc, cmd, a, b));
+}
+
+/* Undo last command if available */
+void undoCommand(Calculator* calc) {
+    if (calc->lastCommand == NULL) {
+        printf("No operation to undo.\n");
+        return;
+    }
+    calc->lastCommand->undo(&(calc->currentResult), calc->lastOperand);
+    printf("Undo performed. Result: %d\n", calc->currentResult);
+}
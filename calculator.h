@@ -0,0 +1,39 @@
+/*
+ * Calculator using Command Pattern (library part of prgm4.c)
+ * ----------------------------------------------------------
+ * Commands and the invoker. executeCommand() prints the result (and the
+ * division-by-zero error) as before; runCommand() and the commands
+ * themselves never print, so non-interactive callers stay quiet.
+ */
+#ifndef CALCULATOR_H
+#define CALCULATOR_H
+
+/* ----- COMMAND INTERFACE ----- */
+typedef struct Command {
+    int (*execute)(int a, int b);      // performs the operation
+    void (*undo)(int* result, int b);  // reverts last operation
+} Command;
+
+/* ----- INVOKER ----- */
+typedef struct {
+    int currentResult;   // holds latest result
+    Command* lastCommand; // pointer to last used command
+    int lastOperand;     // store last b (for undo)
+} Calculator;
+
+/* ----- CONCRETE COMMANDS ----- */
+int add(int a, int b);
+void undoAdd(int* result, int b);
+int subtract(int a, int b);
+void undoSubtract(int* result, int b);
+int multiply(int a, int b);
+void undoMultiply(int* result, int b);
+int divide(int a, int b);
+void undoDivide(int* result, int b);
+
+/* ----- INVOKER OPERATIONS ----- */
+int runCommand(Calculator* calc, Command* cmd, int a, int b);
+void executeCommand(Calculator* calc, Command* cmd, int a, int b);
+void undoCommand(Calculator* calc);
+
+#endif /* CALCULATOR_H */
@@ -0,0 +1,196 @@
+/*
+ * Hot-path instrumentation (see instrument.h)
+ * Without -DINSTRUMENT only the always-available entry points remain, and
+ * instrDump() reports {"enabled": false}.
+ */
+#define _POSIX_C_SOURCE 200809L   // for clock_gettime()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <signal.h>   // for sigwait() in the dump watcher
+#include "instrument.h"
+
+bool instrEnabled(void) {
+#ifdef INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+void instrDumpAtExit(void) {
+    instrDump(stderr);
+}
+
+#ifdef INSTRUMENT
+
+/* Watcher thread: SIGUSR1 is blocked everywhere and collected here with
+ * sigwait(), so the dump runs in normal thread context (no stdio in a
+ * signal handler) and appears at once, even while main waits in scanf. */
+static void* dumpWatcher(void* arg) {
+    sigset_t* set = (sigset_t*)arg;
+    int sig;
+    while (sigwait(set, &sig) == 0) {
+        instrDump(stderr);
+    }
+    return NULL;
+}
+
+void instrDumpOnSignal(void) {
+    static sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGUSR1);
+    // Threads created later inherit this mask, so only the watcher sees SIGUSR1
+    if (pthread_sigmask(SIG_BLOCK, &set, NULL) != 0) {
+        printf("Warning: Cannot block SIGUSR1; on-demand dumps disabled.\n");
+        return;
+    }
+    pthread_t watcher;
+    if (pthread_create(&watcher, NULL, dumpWatcher, &set) != 0) {
+        printf("Warning: Cannot start dump thread; on-demand dumps disabled.\n");
+        pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+        return;
+    }
+    pthread_detach(watcher);
+}
+
+_Thread_local InstrBlock* instrLocal;
+
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+static InstrBlock* registry;        // every block ever registered
+static int registeredThreads;
+static uint64_t startTicks, startNanos;  // calibration point for ticks -> ns
+
+static uint64_t monotonicNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#if !defined(__x86_64__) && !defined(__i386__)
+uint64_t instrTicks(void) {
+    return monotonicNanos();
+}
+#endif
+
+/* Called once per thread, on its first instrumented event. Blocks are
+ * never freed so the totals of finished threads survive until the dump. */
+InstrBlock* instrRegister(void) {
+    InstrBlock* block = (InstrBlock*)calloc(1, sizeof(InstrBlock));
+    if (!block) {
+        printf("Error: Memory allocation failed.\n");
+        exit(1);
+    }
+
+    pthread_mutex_lock(&registryLock);
+    if (registry == NULL) {
+        startTicks = instrTicks();
+        startNanos = monotonicNanos();
+    }
+    block->next = registry;
+    registry = block;
+    registeredThreads++;
+    pthread_mutex_unlock(&registryLock);
+
+    instrLocal = block;
+    return block;
+}
+
+static uint64_t load(_Atomic uint64_t* cell) {
+    return atomic_load_explicit(cell, memory_order_relaxed);
+}
+
+/* Converts ticks to ns using the time elapsed since the first block */
+static double nanosPerTick(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t ticks = instrTicks() - startTicks;
+    uint64_t nanos = monotonicNanos() - startNanos;
+    return ticks > 0 ? (double)nanos / (double)ticks : 0.0;
+#else
+    return 1.0;  // ticks already are nanoseconds
+#endif
+}
+
+void instrDump(FILE* out) {
+    static const char* counterNames[] = {
+#define INSTR_NAME(id, name) name,
+        INSTR_COUNTERS(INSTR_NAME)
+    };
+    static const char* gaugeNames[] = { INSTR_GAUGES(INSTR_NAME) };
+    static const char* spanNames[] = { INSTR_SPANS(INSTR_NAME) };
+#undef INSTR_NAME
+
+    uint64_t counters[COUNTER_COUNT] = {0}, gauges[GAUGE_COUNT] = {0};
+    uint64_t spanCount[SPAN_COUNT] = {0}, spanTicks[SPAN_COUNT] = {0}, spanMax[SPAN_COUNT] = {0};
+
+    pthread_mutex_lock(&registryLock);
+    for (InstrBlock* b = registry; b != NULL; b = b->next) {
+        for (int i = 0; i < COUNTER_COUNT; i++) counters[i] += load(&b->counters[i]);
+        for (int i = 0; i < GAUGE_COUNT; i++) {
+            uint64_t v = load(&b->gauges[i]);
+            if (v > gauges[i]) gauges[i] = v;
+        }
+        for (int i = 0; i < SPAN_COUNT; i++) {
+            spanCount[i] += load(&b->spans[i].count);
+            spanTicks[i] += load(&b->spans[i].ticks);
+            uint64_t m = load(&b->spans[i].maxTicks);
+            if (m > spanMax[i]) spanMax[i] = m;
+        }
+    }
+    int threads = registeredThreads;
+    double scale = registry ? nanosPerTick() : 0.0;
+    pthread_mutex_unlock(&registryLock);
+
+    fprintf(out, "{\"enabled\": true, \"threads\": %d, \"counters\": {", threads);
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        fprintf(out, "%s\"%s\": %llu", i ? ", " : "", counterNames[i],
+                (unsigned long long)counters[i]);
+    }
+    fprintf(out, "}, \"gauges\": {");
+    for (int i = 0; i < GAUGE_COUNT; i++) {
+        fprintf(out, "%s\"%s\": %llu", i ? ", " : "", gaugeNames[i],
+                (unsigned long long)gauges[i]);
+    }
+    fprintf(out, "}, \"spans\": {");
+    for (int i = 0; i < SPAN_COUNT; i++) {
+        double total = (double)spanTicks[i] * scale;
+        fprintf(out, "%s\"%s\": {\"count\": %llu, \"total_ns\": %.0f, "
+                "\"mean_ns\": %.1f, \"max_ns\": %.0f}",
+                i ? ", " : "", spanNames[i], (unsigned long long)spanCount[i], total,
+                spanCount[i] ? total / (double)spanCount[i] : 0.0,
+                (double)spanMax[i] * scale);
+    }
+    fprintf(out, "}}\n");
+    fflush(out);
+}
+
+void instrReset(void) {
+    pthread_mutex_lock(&registryLock);
+    for (InstrBlock* b = registry; b != NULL; b = b->next) {
+        for (int i = 0; i < COUNTER_COUNT; i++) atomic_store(&b->counters[i], 0);
+        for (int i = 0; i < GAUGE_COUNT; i++) atomic_store(&b->gauges[i], 0);
+        for (int i = 0; i < SPAN_COUNT; i++) {
+            atomic_store(&b->spans[i].count, 0);
+            atomic_store(&b->spans[i].ticks, 0);
+            atomic_store(&b->spans[i].maxTicks, 0);
+        }
+    }
+    pthread_mutex_unlock(&registryLock);
+}
+
+#else  /* !INSTRUMENT */
+
+void instrDump(FILE* out) {
+    fprintf(out, "{\"enabled\": false}\n");
+    fflush(out);
+}
+
+void instrReset(void) {
+}
+
+void instrDumpOnSignal(void) {
+}
+
+#endif /* INSTRUMENT */
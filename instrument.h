@@ -0,0 +1,135 @@
+/*
+ * Hot-path instrumentation
+ * ------------------------
+ * Per-thread event counters, max gauges and timing spans for the core
+ * operations of all five programs. Enabled only when compiled with
+ * -DINSTRUMENT (make INSTRUMENT=1); otherwise every INSTR_* macro expands
+ * to nothing, so the instrumented code is identical to the plain build.
+ *
+ * Each thread updates its own block (no locks, no shared cache lines);
+ * instrDump() sums all blocks, including those of finished threads.
+ * Dumps on demand: the programs start a watcher thread that prints the
+ * dump to stderr on every SIGUSR1 (kill -USR1 <pid>), plus once at exit.
+ * Spans are timed with rdtsc on x86 and clock_gettime elsewhere.
+ */
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* ----- EVENT LISTS: X(id, name used in the dump) ----- */
+#define INSTR_COUNTERS(X) \
+    X(BOOK_STORE_FULL,          "book_store_full") \
+    X(BOOK_FIND_COMPARES,       "book_find_compares") \
+    X(BOOK_FIND_MISSES,         "book_find_misses") \
+    X(STACK_OVERFLOWS,          "stack_overflows") \
+    X(STACK_UNDERFLOWS,         "stack_underflows") \
+    X(COMMAND_DIVIDE_BY_ZERO,   "command_divide_by_zero") \
+    X(BST_SEARCH_NODES_VISITED, "bst_search_nodes_visited") \
+    X(BST_SEARCH_MISSES,        "bst_search_misses") \
+    X(BST_INSERT_DUPLICATES,    "bst_insert_duplicates") \
+    X(BST_DELETE_MISSES,        "bst_delete_misses")
+
+#define INSTR_GAUGES(X) \
+    X(BST_SEARCH_DEPTH_MAX,     "bst_search_depth_max")
+
+#define INSTR_SPANS(X) \
+    X(STORE_BOOK,               "storeBook") \
+    X(FIND_BOOK,                "findBook") \
+    X(CALCULATE_MEAN,           "calculateMean") \
+    X(CALCULATE_STDDEV,         "calculateStdDev") \
+    X(STACK_PUSH,               "stackPush") \
+    X(STACK_POP,                "stackPop") \
+    X(RUN_COMMAND,              "runCommand") \
+    X(BST_INSERT,               "insert") \
+    X(BST_SEARCH,               "search") \
+    X(BST_DELETE,               "deleteNode")
+
+#define INSTR_ENUM_COUNTER(id, name) COUNTER_##id,
+#define INSTR_ENUM_GAUGE(id, name) GAUGE_##id,
+#define INSTR_ENUM_SPAN(id, name) SPAN_##id,
+typedef enum { INSTR_COUNTERS(INSTR_ENUM_COUNTER) COUNTER_COUNT } InstrCounter;
+typedef enum { INSTR_GAUGES(INSTR_ENUM_GAUGE) GAUGE_COUNT } InstrGauge;
+typedef enum { INSTR_SPANS(INSTR_ENUM_SPAN) SPAN_COUNT } InstrSpan;
+
+/* ----- FUNCTION DECLARATIONS (available in every build) ----- */
+bool instrEnabled(void);          // true if compiled with -DINSTRUMENT
+void instrDump(FILE* out);        // JSON object with totals over all threads
+void instrReset(void);            // zero all totals (call while quiescent)
+void instrDumpAtExit(void);       // atexit() handler: instrDump(stderr)
+void instrDumpOnSignal(void);     // SIGUSR1 -> instrDump(stderr); call before creating threads
+
+#ifdef INSTRUMENT
+
+/* ----- PER-THREAD BLOCK ----- */
+/* Only the owning thread writes its block; relaxed atomics make the
+ * concurrent reads in instrDump() well-defined at plain-store cost. */
+typedef struct {
+    _Atomic uint64_t count;
+    _Atomic uint64_t ticks;
+    _Atomic uint64_t maxTicks;
+} InstrSpanStats;
+
+typedef struct InstrBlock {
+    _Atomic uint64_t counters[COUNTER_COUNT];
+    _Atomic uint64_t gauges[GAUGE_COUNT];
+    InstrSpanStats spans[SPAN_COUNT];
+    struct InstrBlock* next;      // registry of all threads' blocks
+} InstrBlock;
+
+extern _Thread_local InstrBlock* instrLocal;
+InstrBlock* instrRegister(void);  // allocates this thread's block
+
+static inline InstrBlock* instrBlock(void) {
+    InstrBlock* block = instrLocal;
+    return block ? block : instrRegister();
+}
+
+static inline void instrBump(_Atomic uint64_t* cell, uint64_t n) {
+    atomic_store_explicit(cell, atomic_load_explicit(cell, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+static inline void instrRaise(_Atomic uint64_t* cell, uint64_t value) {
+    if (value > atomic_load_explicit(cell, memory_order_relaxed)) {
+        atomic_store_explicit(cell, value, memory_order_relaxed);
+    }
+}
+
+/* ----- TIME SOURCE ----- */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t instrTicks(void) { return __rdtsc(); }
+#else
+uint64_t instrTicks(void);        // clock_gettime(CLOCK_MONOTONIC) in ns
+#endif
+
+static inline void instrRecordSpan(InstrSpan id, uint64_t ticks) {
+    InstrSpanStats* span = &instrBlock()->spans[id];
+    instrBump(&span->count, 1);
+    instrBump(&span->ticks, ticks);
+    instrRaise(&span->maxTicks, ticks);
+}
+
+#define INSTR_COUNT(id, n)   instrBump(&instrBlock()->counters[COUNTER_##id], (uint64_t)(n))
+#define INSTR_MAX(id, v)     instrRaise(&instrBlock()->gauges[GAUGE_##id], (uint64_t)(v))
+#define INSTR_SPAN_BEGIN(id) uint64_t instrStart_##id = instrTicks()
+#define INSTR_SPAN_END(id)   instrRecordSpan(SPAN_##id, instrTicks() - instrStart_##id)
+#define INSTR_DUMP_AT_EXIT() atexit(instrDumpAtExit)
+#define INSTR_DUMP_ON_SIGNAL() instrDumpOnSignal()
+
+#else  /* !INSTRUMENT: compiled out entirely */
+
+#define INSTR_COUNT(id, n)   ((void)0)
+#define INSTR_MAX(id, v)     ((void)0)
+#define INSTR_SPAN_BEGIN(id) ((void)0)
+#define INSTR_SPAN_END(id)   ((void)0)
+#define INSTR_DUMP_AT_EXIT() ((void)0)
+#define INSTR_DUMP_ON_SIGNAL() ((void)0)
+
+#endif /* INSTRUMENT */
+
+#endif /* INSTRUMENT_H */
@@ -0,0 +1,91 @@
+/*
+ * Library Management core (see library.h)
+ * Functions here never read input; prgm1.c handles the user dialogue.
+ */
+
+#include <stdio.h>   // Standard Input/Output library
+#include <string.h>  // For string comparison (strcmp) and copying
+#include "library.h"
+#include "instrument.h"
+
+/* Copies src into a fixed-size field, always NUL-terminated */
+static void copyField(char *dest, const char *src, size_t size) {
+    strncpy(dest, src, size - 1);
+    dest[size - 1] = '\0';
+}
+
+/*
+ * Function: storeBook
+ * -------------------
+ * Appends a book to the collection if space is available.
+ * Over-long fields are truncated to fit.
+ * Returns:
+ *   true if the book was stored, false if the library is full
+ */
+bool storeBook(Book books[], int *count, const char *title,
+               const char *author, const char *isbn) {
+    INSTR_SPAN_BEGIN(STORE_BOOK);
+
+    // Check if library is already full
+    if (*count >= MAX_BOOKS) {
+        INSTR_COUNT(BOOK_STORE_FULL, 1);
+        INSTR_SPAN_END(STORE_BOOK);
+        return false;
+    }
+
+    copyField(books[*count].title, title, TITLE_LEN);
+    copyField(books[*count].author, author, AUTHOR_LEN);
+    copyField(books[*count].isbn, isbn, ISBN_LEN);
+
+    // Increment total book count after successful entry
+    (*count)++;
+    INSTR_SPAN_END(STORE_BOOK);
+    return true;
+}
+
+/*
+ * Function: findBook
+ * ------------------
+ * Looks up a book by exact title.
+ * Returns:
+ *   index of the first matching book, or -1 if there is none
+ */
+int findBook(const Book books[], int count, const char *title) {
+    INSTR_SPAN_BEGIN(FIND_BOOK);
+
+    // Loop through all books to find a match
+    for (int i = 0; i < count; i++) {
+        if (strcmp(books[i].title, title) == 0) {  // Compare input title with stored titles
+            INSTR_COUNT(BOOK_FIND_COMPARES, i + 1);
+            INSTR_SPAN_END(FIND_BOOK);
+            return i;
+        }
+    }
+    INSTR_COUNT(BOOK_FIND_COMPARES, count);
+    INSTR_COUNT(BOOK_FIND_MISSES, 1);
+    INSTR_SPAN_END(FIND_BOOK);
+    return -1;
+}
+
+/*
+ * Function: displayBooks
+ * ----------------------
+ * Displays all books currently in the library.
+ * Parameters:
+ *   books[]: Array of books
+ *   count: Total number of books stored
+ */
+void displayBooks(Book books[], int count) {
+    // If no books are stored
+    if (count == 0) {
+        printf("No books available.\n");
+        return;
+    }
+
+    // Print all books in formatted style
+    printf("\nAvailable Books:\n");
+    for (int i = 0; i < count; i++) {
+        printf("%d. Title: %s | Author: %s | ISBN: %s\n",
+               i + 1, books[i].title, books[i].author, books[i].isbn);
+    }
+}
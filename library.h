@@ -0,0 +1,32 @@
+/*
+ * Library Management core (library part of prgm1.c)
+ * -------------------------------------------------
+ * Book storage and lookup without any user interaction, so the same code
+ * serves the interactive menu and the benchmark driver.
+ */
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <stdbool.h>
+
+/* ----- CONSTANTS ----- */
+#define MAX_BOOKS 100     // Maximum number of books that can be stored
+#define TITLE_LEN 100     // Maximum length of book title
+#define AUTHOR_LEN 100    // Maximum length of author name
+#define ISBN_LEN 20       // Maximum length of ISBN
+
+/* ----- STRUCTURE DEFINITION ----- */
+/* Book structure stores information of a single book */
+typedef struct {
+    char title[TITLE_LEN];   // Title of the book
+    char author[AUTHOR_LEN]; // Author of the book
+    char isbn[ISBN_LEN];     // ISBN number of the book
+} Book;
+
+/* ----- FUNCTION DECLARATIONS ----- */
+bool storeBook(Book books[], int *count, const char *title,
+               const char *author, const char *isbn); // Appends a book if space is left
+int findBook(const Book books[], int count, const char *title); // Index of title or -1
+void displayBooks(Book books[], int count); // Displays all available books
+
+#endif /* LIBRARY_H */
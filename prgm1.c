@@ -16,39 +16,28 @@
  */
 
 #include <stdio.h>   // Standard Input/Output library
-#include <string.h>  // For string comparison (strcmp)
-
-/* ----- CONSTANTS ----- */
-#define MAX_BOOKS 100     // Maximum number of books that can be stored
-#define TITLE_LEN 100     // Maximum length of book title
-#define AUTHOR_LEN 100    // Maximum length of author name
-#define ISBN_LEN 20       // Maximum length of ISBN
-
-/* ----- STRUCTURE DEFINITION ----- */
-/* Book structure stores information of a single book */
-typedef struct {
-    char title[TITLE_LEN];   // Title of the book
-    char author[AUTHOR_LEN]; // Author of the book
-    char isbn[ISBN_LEN];     // ISBN number of the book
-} Book;
+#include <stdlib.h>  // For atexit() used by instrumentation
+#include "library.h" // Book storage and lookup (compiled into libminiproject.a)
+#include "instrument.h" // Optional hot-path counters
 
 /* ----- FUNCTION DECLARATIONS ----- */
 /* These are prototypes (declarations) for functions defined later */
 void addBook(Book books[], int *count);     // Adds a new book to the library
 void searchBook(Book books[], int count);   // Searches for a book by title
-void displayBooks(Book books[], int count); // Displays all available books
 
 /* ----- FUNCTION DEFINITIONS ----- */
 
 /*
  * Function: addBook
  * -----------------
- * Adds a new book to the collection if space is available.
+ * Reads a new book from the user and stores it if space is available.
  * Parameters:
  *   books[]: Array that stores all books
  *   count: Pointer to number of books currently stored
  */
 void addBook(Book books[], int *count) {
+    char title[TITLE_LEN], author[AUTHOR_LEN], isbn[ISBN_LEN];
+
     // Check if library is already full
     if (*count >= MAX_BOOKS) {
         printf("Library is full. Cannot add more books.\n");
@@ -57,23 +46,23 @@ void addBook(Book books[], int *count) {
 
     // Take book details from the user
     printf("Enter Title: ");
-    scanf(" %[^\n]s", books[*count].title);   // Reads full string including spaces
+    scanf(" %[^\n]s", title);   // Reads full string including spaces
 
     printf("Enter Author: ");
-    scanf(" %[^\n]s", books[*count].author);
+    scanf(" %[^\n]s", author);
 
     printf("Enter ISBN: ");
-    scanf(" %[^\n]s", books[*count].isbn);
+    scanf(" %[^\n]s", isbn);
 
-    // Increment total book count after successful entry
-    (*count)++;
-    printf("Book added successfully!\n");
+    if (storeBook(books, count, title, author, isbn)) {
+        printf("Book added successfully!\n");
+    }
 }
 
 /*
  * Function: searchBook
  * --------------------
- * Searches for a book by title in the collection.
+ * Asks for a title and prints the matching book, if any.
  * Parameters:
  *   books[]: Array of books
  *   count: Total number of books stored
@@ -84,40 +73,13 @@ void searchBook(Book books[], int count) {
     printf("Enter title to search: ");
     scanf(" %[^\n]s", title);  // Read the search string including spaces
 
-    // Loop through all books to find a match
-    for (int i = 0; i < count; i++) {
-        if (strcmp(books[i].title, title) == 0) {  // Compare input title with stored titles
-            printf("\nBook Found:\nTitle: %s\nAuthor: %s\nISBN: %s\n",
-                   books[i].title, books[i].author, books[i].isbn);
-            return; // Exit function once book is found
-        }
-    }
-
-    // If loop ends without finding a match
-    printf("Book not found.\n");
-}
-
-/*
- * Function: displayBooks
- * ----------------------
- * Displays all books currently in the library.
- * Parameters:
- *   books[]: Array of books
- *   count: Total number of books stored
- */
-void displayBooks(Book books[], int count) {
-    // If no books are stored
-    if (count == 0) {
-        printf("No books available.\n");
+    int i = findBook(books, count, title);
+    if (i < 0) {
+        printf("Book not found.\n");
         return;
     }
-
-    // Print all books in formatted style
-    printf("\nAvailable Books:\n");
-    for (int i = 0; i < count; i++) {
-        printf("%d. Title: %s | Author: %s | ISBN: %s\n",
-               i + 1, books[i].title, books[i].author, books[i].isbn);
-    }
+    printf("\nBook Found:\nTitle: %s\nAuthor: %s\nISBN: %s\n",
+           books[i].title, books[i].author, books[i].isbn);
 }
 
 /*
@@ -127,6 +89,9 @@ void displayBooks(Book books[], int count) {
  * Provides a menu-driven interface to the user.
  */
 int main() {
+    INSTR_DUMP_AT_EXIT();    // counters to stderr on exit (INSTRUMENT builds only)
+    INSTR_DUMP_ON_SIGNAL();  // ... and on every SIGUSR1
+
     Book books[MAX_BOOKS];  // Array to store all books
     int count = 0;          // Current number of books
     int choice;             // Menu choice variable
@@ -9,15 +9,12 @@ o Handle invalid, non-integer, or out-of-range inputs gracefully.
 • Include detailed in-code comments describing how errors are detected and handled.
 • Summarize (in 100-150 words) how your code design ensures robustness and prevents common runtime errors.*/#include <stdio.h>
 #include <stdlib.h>   // for exit()
-#include <math.h>     // for sqrt()
 #include <string.h>   // for strtok
-
-#define MAX_NUMBERS 100   // prevent buffer overflow
+#include "stats.h"    // calculateMean(), calculateStdDev(), MAX_NUMBERS
+#include "instrument.h" // optional hot-path counters
 
 /* ----- FUNCTION DECLARATIONS ----- */
 int getInput(int numbers[]);
-double calculateMean(int numbers[], int count);
-double calculateStdDev(int numbers[], int count, double mean);
 
 /* Function: getInput
  * -------------------
@@ -71,27 +68,11 @@ int getInput(int numbers[]) {
     return count;
 }
 
-/* Function: calculateMean */
-double calculateMean(int numbers[], int count) {
-    double sum = 0.0;
-    for (int i = 0; i < count; i++) {
-        sum += numbers[i];
-    }
-    return sum / count;
-}
-
-/* Function: calculateStdDev */
-double calculateStdDev(int numbers[], int count, double mean) {
-    double variance = 0.0;
-    for (int i = 0; i < count; i++) {
-        variance += pow(numbers[i] - mean, 2);
-    }
-    variance /= count;
-    return sqrt(variance);
-}
-
 /* ----- MAIN PROGRAM ----- */
 int main() {
+    INSTR_DUMP_AT_EXIT();    // counters to stderr on exit (INSTRUMENT builds only)
+    INSTR_DUMP_ON_SIGNAL();  // ... and on every SIGUSR1
+
     int numbers[MAX_NUMBERS];
 
     int count = getInput(numbers);
@@ -21,98 +21,14 @@ o bool isEmpty(Stack* s) 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>   // for bool type
-
-/* ----- STRUCTURE DEFINITION ----- */
-typedef struct {
-    int *arr;       // dynamically allocated array to hold stack elements
-    int top;        // index of the top element (-1 when empty)
-    int capacity;   // maximum number of elements
-} Stack;
-
-/* ----- FUNCTION DECLARATIONS ----- */
-Stack* createStack(int capacity);
-void push(Stack* s, int item);
-int pop(Stack* s);
-bool isEmpty(Stack* s);
-void display(Stack* s);
-
-/* Function: createStack
- * ----------------------
- * Dynamically allocates memory for a stack with given capacity.
- * Initializes top = -1 (empty).
- */
-Stack* createStack(int capacity) {
-    Stack* s = (Stack*) malloc(sizeof(Stack));
-    if (!s) {
-        printf("Error: Memory allocation failed.\n");
-        exit(1);  // terminate safely if malloc fails
-    }
-
-    s->capacity = capacity;
-    s->top = -1;   // stack starts empty
-    s->arr = (int*) malloc(capacity * sizeof(int));
-
-    if (!s->arr) {
-        printf("Error: Memory allocation for stack array failed.\n");
-        free(s);   // free already allocated memory
-        exit(1);
-    }
-
-    return s;
-}
-
-/* Function: push
- * ----------------
- * Adds an element on top of the stack.
- * If the stack is full, prints error (overflow).
- */
-void push(Stack* s, int item) {
-    if (s->top == s->capacity - 1) {
-        printf("Error: Stack Overflow. Cannot push %d.\n", item);
-        return;
-    }
-    s->arr[++s->top] = item;   // increment top, then assign value
-    printf("Pushed %d onto stack.\n", item);
-}
-
-/* Function: pop
- * --------------
- * Removes and returns the top element of the stack.
- * If the stack is empty, prints error (underflow).
- */
-int pop(Stack* s) {
-    if (isEmpty(s)) {
-        printf("Error: Stack Underflow. Cannot pop.\n");
-        return -1;   // sentinel value to indicate failure
-    }
-    return s->arr[s->top--];   // return current top, then decrement
-}
-
-/* Function: isEmpty
- * ------------------
- * Returns true if stack has no elements.
- */
-bool isEmpty(Stack* s) {
-    return s->top == -1;
-}
-
-/* Function: display
- * ------------------
- * Prints all elements of the stack from top to bottom.
- */
-void display(Stack* s) {
-    if (isEmpty(s)) {
-        printf("Stack is empty.\n");
-        return;
-    }
-    printf("Stack elements (top to bottom):\n");
-    for (int i = s->top; i >= 0; i--) {
-        printf("%d\n", s->arr[i]);
-    }
-}
+#include "stack.h"     // Stack and its operations (compiled into libminiproject.a)
+#include "instrument.h" // optional hot-path counters
 
 /* ----- MAIN PROGRAM ----- */
 int main() {
+    INSTR_DUMP_AT_EXIT();    // counters to stderr on exit (INSTRUMENT builds only)
+    INSTR_DUMP_ON_SIGNAL();  // ... and on every SIGUSR1
+
     int capacity, choice, value;
     Stack* s = NULL;
 
@@ -164,8 +80,7 @@ int main() {
         }
     } while (choice != 5);
 
-    free(s->arr);  // free dynamically allocated memory
-    free(s);
+    freeStack(s);  // free dynamically allocated memory
 
     return 0;
 }
@@ -24,66 +24,14 @@ o Stores a history of operations (for undo functionality, if implemented).*/
 
 #include <stdio.h>
 #include <stdlib.h>
-
-/* ----- COMMAND INTERFACE ----- */
-typedef struct Command {
-    int (*execute)(int a, int b);      // performs the operation
-    void (*undo)(int* result, int b);  // reverts last operation
-} Command;
-
-/* ----- CONCRETE COMMANDS ----- */
-
-// ADDITION
-int add(int a, int b) { return a + b; }
-void undoAdd(int* result, int b) { *result -= b; } // reverse by subtracting
-
-// SUBTRACTION
-int subtract(int a, int b) { return a - b; }
-void undoSubtract(int* result, int b) { *result += b; } // reverse by adding
-
-// MULTIPLICATION
-int multiply(int a, int b) { return a * b; }
-void undoMultiply(int* result, int b) {
-    if (b != 0) *result /= b;  // reverse by dividing (if possible)
-}
-
-// DIVISION
-int divide(int a, int b) {
-    if (b == 0) {
-        printf("Error: Division by zero!\n");
-        return a;  // return unchanged
-    }
-    return a / b;
-}
-void undoDivide(int* result, int b) { *result *= b; } // reverse by multiplying
-
-/* ----- INVOKER ----- */
-typedef struct {
-    int currentResult;   // holds latest result
-    Command* lastCommand; // pointer to last used command
-    int lastOperand;     // store last b (for undo)
-} Calculator;
-
-/* Executes chosen command */
-void executeCommand(Calculator* calc, Command* cmd, int a, int b) {
-    calc->currentResult = cmd->execute(a, b);  // run operation
-    calc->lastCommand = cmd;                   // remember command
-    calc->lastOperand = b;                     // remember operand
-    printf("Result: %d\n", calc->currentResult);
-}
-
-/* Undo last command if available */
-void undoCommand(Calculator* calc) {
-    if (calc->lastCommand == NULL) {
-        printf("No operation to undo.\n");
-        return;
-    }
-    calc->lastCommand->undo(&(calc->currentResult), calc->lastOperand);
-    printf("Undo performed. Result: %d\n", calc->currentResult);
-}
+#include "calculator.h"  // commands and invoker (compiled into libminiproject.a)
+#include "instrument.h"  // optional hot-path counters
 
 /* ----- MAIN PROGRAM ----- */
 int main() {
+    INSTR_DUMP_AT_EXIT();    // counters to stderr on exit (INSTRUMENT builds only)
+    INSTR_DUMP_ON_SIGNAL();  // ... and on every SIGUSR1
+
     // Define commands
     Command addCmd = {add, undoAdd};
     Command subCmd = {subtract, undoSubtract};
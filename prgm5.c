@@ -8,123 +8,281 @@ non-existent values).
 o Organize code into well-defined functions (insert, search, delete, display).
 • Include detailed comments on error detection and handling.
 • Summarize (in 100-150 words) how your design and error management prevent crashes and improper tree operations.*/
+#define _POSIX_C_SOURCE 200809L   // for clock_gettime(), nanosleep()
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
-
-/* ----- BST NODE STRUCTURE ----- */
-typedef struct Node {
-    int data;
-    struct Node *left, *right;
-} Node;
+#include <time.h>       // for clock_gettime() in the benchmarks
+#include <pthread.h>    // for the concurrent benchmark
+#include <stdatomic.h>
+#include <unistd.h>     // for sysconf()
+#include "bst.h"        // tree operations (compiled into libminiproject.a)
+#include "instrument.h" // optional hot-path counters
 
 /* ----- FUNCTION DECLARATIONS ----- */
-Node* createNode(int value);
-Node* insert(Node* root, int value);
-Node* search(Node* root, int value);
-Node* deleteNode(Node* root, int value);
-Node* findMin(Node* root);
-void inorder(Node* root);
-
-/* ----- CREATE NEW NODE ----- */
-Node* createNode(int value) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (!newNode) {  // defensive check: memory allocation
-        printf("Error: Memory allocation failed.\n");
-        exit(1);
-    }
-    newNode->data = value;
-    newNode->left = newNode->right = NULL;
-    return newNode;
+/* Tree operations are declared in bst.h; only the benchmarks live here */
+void benchmarkBulkLoad(int n);
+void benchmarkConcurrent(int keys, int maxThreads);
+
+/* ----- BULK LOAD BENCHMARK ----- */
+static double elapsedSeconds(struct timespec start, struct timespec end) {
+    return (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
 }
 
-/* ----- INSERT INTO BST ----- */
-Node* insert(Node* root, int value) {
-    if (root == NULL) {
-        return createNode(value);  // base case
+/* Times bulkLoad() on keys 0..n-1 against n repeated insert() calls on the
+ * same keys in shuffled order (sorted order would degenerate into a list). */
+void benchmarkBulkLoad(int n) {
+    if (n <= 0) {
+        printf("Error: Key count must be positive.\n");
+        return;
     }
-    if (value < root->data) {
-        root->left = insert(root->left, value);
-    } else if (value > root->data) {
-        root->right = insert(root->right, value);
-    } else {
-        printf("Warning: Duplicate value %d ignored.\n", value);//defensive programming
+
+    int* keys = (int*)checkedMalloc((size_t)n * sizeof(int));
+    for (int i = 0; i < n; i++) keys[i] = i;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Node* bulk = bulkLoad(keys, n);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double bulkTime = elapsedSeconds(start, end);
+    freeTree(bulk);
+
+    unsigned int seed = 12345;  // fixed seed: reproducible shuffle
+    for (int i = n - 1; i > 0; i--) {
+        seed = seed * 1103515245u + 12345u;
+        int j = (int)(((unsigned long long)seed * (unsigned)(i + 1)) >> 32);
+        int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
     }
-    return root;
+
+    Node* root = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < n; i++) root = insert(root, keys[i]);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double insertTime = elapsedSeconds(start, end);
+    freeTree(root);
+    free(keys);
+
+    printf("Keys: %d\n", n);
+    printf("Bulk load:        %.3f s\n", bulkTime);
+    printf("Repeated insert:  %.3f s\n", insertTime);
+    if (bulkTime > 0) printf("Speedup:          %.1fx\n", insertTime / bulkTime);
 }
 
-/* ----- SEARCH IN BST ----- */
-Node* search(Node* root, int value) {
-    if (root == NULL) {
-        return NULL;  // not found
+/* ----- CONCURRENT BENCHMARK ----- */
+/* Tree holds the even keys 0..2(keys-1); readers look up random keys (half
+ * hit), one writer inserts and deletes random odd keys. The same workload
+ * runs against the original functions behind a pthread_rwlock as baseline. */
+
+typedef struct {
+    ConcurrentBST* cow;         // copy-on-write tree, or NULL for baseline
+    Node** root;                // baseline tree
+    pthread_rwlock_t* lock;     // baseline lock
+    atomic_bool* running;
+    int reader, keys;
+    unsigned long ops;
+} BenchThread;
+
+static unsigned int nextRandom(unsigned int* state) {  // xorshift32
+    unsigned int x = *state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return *state = x;
+}
+
+static void* benchReader(void* arg) {
+    BenchThread* t = (BenchThread*)arg;
+    unsigned int rng = 2463534242u + (unsigned)t->reader;
+    unsigned long ops = 0;
+    while (atomic_load_explicit(t->running, memory_order_relaxed)) {
+        int value = (int)(nextRandom(&rng) % (2u * (unsigned)t->keys));
+        if (t->cow) {
+            concurrentSearch(t->cow, t->reader, value);
+        } else {
+            pthread_rwlock_rdlock(t->lock);
+            search(*t->root, value);
+            pthread_rwlock_unlock(t->lock);
+        }
+        ops++;
     }
-    if (root->data == value) {
-        return root;
-    } else if (value < root->data) {
-        return search(root->left, value);
-    } else {
-        return search(root->right, value);
+    t->ops = ops;
+    return NULL;
+}
+
+static void* benchWriter(void* arg) {
+    BenchThread* t = (BenchThread*)arg;
+    unsigned int rng = 88675123u;
+    unsigned long ops = 0;
+    while (atomic_load_explicit(t->running, memory_order_relaxed)) {
+        int value = (int)(nextRandom(&rng) % (unsigned)t->keys) * 2 + 1;
+        if (t->cow) {
+            concurrentInsert(t->cow, value);
+            concurrentDelete(t->cow, value);
+        } else {
+            pthread_rwlock_wrlock(t->lock);
+            *t->root = insert(*t->root, value);
+            pthread_rwlock_unlock(t->lock);
+            pthread_rwlock_wrlock(t->lock);
+            *t->root = deleteNode(*t->root, value);
+            pthread_rwlock_unlock(t->lock);
+        }
+        ops += 2;
     }
+    t->ops = ops;
+    return NULL;
 }
 
-/* ----- FIND MINIMUM NODE (Helper for deletion) ----- */
-Node* findMin(Node* root) {
-    while (root && root->left != NULL) {
-        root = root->left;
+/* Runs "readers" reader threads plus one writer for one second */
+static void runConcurrentRound(BenchThread* proto, int readers,
+                               double* readRate, double* writeRate) {
+    pthread_t threads[MAX_READERS + 1];
+    BenchThread args[MAX_READERS + 1];
+
+    atomic_store(proto->running, true);
+    for (int i = 0; i <= readers; i++) {
+        args[i] = *proto;
+        args[i].reader = i;
+        args[i].ops = 0;
+        pthread_create(&threads[i], NULL, i < readers ? benchReader : benchWriter, &args[i]);
+    }
+    struct timespec duration = {1, 0};
+    nanosleep(&duration, NULL);
+    atomic_store(proto->running, false);
+
+    unsigned long reads = 0;
+    for (int i = 0; i <= readers; i++) {
+        pthread_join(threads[i], NULL);
+        if (i < readers) reads += args[i].ops;
     }
-    return root;
+    *readRate = (double)reads;
+    *writeRate = (double)args[readers].ops;
 }
 
-/* ----- DELETE NODE FROM BST ----- */
-Node* deleteNode(Node* root, int value) {
-    if (root == NULL) {
-        printf("Error: Cannot delete %d (not found).\n", value);
-        return root;
+/* Runs rounds with 1, 2, 4, ... readers and always a final round at exactly
+ * maxThreads (usually the core count), even when it is not a power of two. */
+void benchmarkConcurrent(int keys, int maxThreads) {
+    if (keys <= 0 || maxThreads <= 0) {
+        printf("Error: Key and thread counts must be positive.\n");
+        return;
     }
+    if (maxThreads > MAX_READERS) maxThreads = MAX_READERS;
 
-    if (value < root->data) {
-        root->left = deleteNode(root->left, value);
-    } else if (value > root->data) {
-        root->right = deleteNode(root->right, value);
-    } else {
-        // Found the node to delete
-        if (root->left == NULL && root->right == NULL) {
-            free(root);
-            return NULL;  // leaf node
-        } else if (root->left == NULL) {
-            Node* temp = root->right;
-            free(root);
-            return temp;
-        } else if (root->right == NULL) {
-            Node* temp = root->left;
-            free(root);
-            return temp;
-        } else {
-            Node* temp = findMin(root->right);  // inorder successor
-            root->data = temp->data;
-            root->right = deleteNode(root->right, temp->data);
-        }
+    int* even = (int*)checkedMalloc((size_t)keys * sizeof(int));
+    for (int i = 0; i < keys; i++) even[i] = 2 * i;
+
+    ConcurrentBST cow;
+    concurrentInit(&cow, bulkLoad(even, keys));
+    Node* root = bulkLoad(even, keys);
+    pthread_rwlock_t lock;
+    pthread_rwlock_init(&lock, NULL);
+    atomic_bool running;
+    atomic_init(&running, false);
+    free(even);
+
+    printf("%-8s %18s %18s %18s %18s\n", "Readers",
+           "COW reads/s", "COW writes/s", "RWLock reads/s", "RWLock writes/s");
+    for (int readers = 1; readers <= maxThreads; ) {
+        double cowReads, cowWrites, lockReads, lockWrites;
+        BenchThread proto = {&cow, NULL, NULL, &running, 0, keys, 0};
+        runConcurrentRound(&proto, readers, &cowReads, &cowWrites);
+        BenchThread base = {NULL, &root, &lock, &running, 0, keys, 0};
+        runConcurrentRound(&base, readers, &lockReads, &lockWrites);
+        printf("%-8d %18.0f %18.0f %18.0f %18.0f\n",
+               readers, cowReads, cowWrites, lockReads, lockWrites);
+
+        if (readers == maxThreads) break;
+        readers = readers * 2 < maxThreads ? readers * 2 : maxThreads;
     }
-    return root;
+
+    concurrentDestroy(&cow);
+    freeTree(root);
+    pthread_rwlock_destroy(&lock);
 }
 
-/* ----- INORDER TRAVERSAL (sorted order) ----- */
-void inorder(Node* root) {
-    if (root != NULL) {
-        inorder(root->left);
-        printf("%d ", root->data);
-        inorder(root->right);
+/* ----- BATCH INPUT ----- */
+/* Reads "count" followed by that many integers for the batch menu options.
+ * Returns a malloc'd array (caller frees) or NULL on invalid input. */
+static int* readBatch(int* count) {
+    printf("Enter number of values: ");
+    if (scanf("%d", count) != 1 || *count <= 0) {
+        printf("Error: Invalid count.\n");
+        return NULL;
+    }
+    int* values = (int*)checkedMalloc((size_t)*count * sizeof(int));
+    printf("Enter %d integers: ", *count);
+    for (int i = 0; i < *count; i++) {
+        if (scanf("%d", &values[i]) != 1) {
+            printf("Error: Invalid integer.\n");
+            free(values);
+            return NULL;
+        }
     }
+    return values;
+}
+
+/* ----- SNAPSHOT CHECKPOINT ----- */
+/* Saves a snapshot as the next generation and starts a fresh (empty) log
+ * after it. A crash in between leaves a log of the old generation, which
+ * the next startup skips, so even a replaced tree (bulk load) is safe.
+ * Returns true if the snapshot was saved, even if the new log could not be
+ * opened (that only prints a warning); on failure the old log is kept. */
+static bool checkpoint(Node* root, const char* snapshotPath, const char* logPath,
+                       FILE** log, uint64_t* generation) {
+    if (!saveSnapshot(root, snapshotPath, *generation + 1)) return false;  // keep the old log
+    (*generation)++;
+    if (*log) fclose(*log);
+    *log = openLog(logPath, *generation);
+    if (!*log) printf("Warning: Cannot reopen log %s; changes will not be logged.\n", logPath);
+    return true;
 }
 
 /* ----- MAIN PROGRAM WITH MENU ----- */
-int main() {
+/* Usage: prgm5 [snapshot-file]
+ * With a snapshot file the tree is restored from it (plus its ".log") at
+ * startup and every insert/delete is logged until the next snapshot. */
+int main(int argc, char* argv[]) {
+    INSTR_DUMP_AT_EXIT();    // counters to stderr on exit (INSTRUMENT builds only)
+    INSTR_DUMP_ON_SIGNAL();  // ... and on every SIGUSR1
+
     Node* root = NULL;
-    int choice, value;
+    int choice, value, count;
+    int* batch;
+    char path[256];
+    const char* snapshotPath = argc > 1 ? argv[1] : NULL;
+    char logPath[512];
+    FILE* log = NULL;
+    uint64_t generation = 0;  // of the loaded snapshot; the log must match it
+
+    if (snapshotPath) {
+        if (snprintf(logPath, sizeof(logPath), "%s.log", snapshotPath) >= (int)sizeof(logPath)) {
+            printf("Error: Snapshot path too long.\n");
+            exit(1);
+        }
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (loadSnapshot(snapshotPath, &root, &generation)
+            && replayLog(logPath, generation, &root)) {
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            printf("Restored %d value(s) from %s in %.3f s.\n",
+                   countNodes(root), snapshotPath, elapsedSeconds(start, end));
+
+            log = openLog(logPath, generation);  // keep appending after the replayed ops
+            if (!log) printf("Warning: Cannot open log %s; changes will not be logged.\n", logPath);
+        } else {
+            // Damaged snapshot or unreadable log: never overwrite either this
+            // session, and do not start from a tree that lacks the log
+            freeTree(root);
+            root = NULL;
+            printf("Warning: Persistence disabled; %s and its log are left untouched.\n",
+                   snapshotPath);
+            snapshotPath = NULL;
+        }
+    }
 
     while (1) {
         printf("\n--- Binary Search Tree Menu ---\n");
-        printf("1. Insert\n2. Search\n3. Delete\n4. Display (In-order)\n5. Exit\n");
+        printf("1. Insert\n2. Search\n3. Delete\n4. Display (In-order)\n");
+        printf("5. Bulk Load (sorted file)\n6. Batch Insert\n7. Batch Delete\n");
+        printf("8. Benchmark Bulk Load\n9. Benchmark Concurrent Access\n");
+        printf("10. Save Snapshot\n11. Exit\n");
         printf("Enter choice: ");
         if (scanf("%d", &choice) != 1) {
             printf("Error: Invalid input. Exiting.\n");
@@ -136,6 +294,7 @@ int main() {
                 printf("Enter value to insert: ");
                 if (scanf("%d", &value) == 1) {
                     root = insert(root, value);
+                    logOperation(log, 'I', value);
                 } else {
                     printf("Error: Invalid integer.\n");
                     exit(1);
@@ -158,6 +317,7 @@ int main() {
                 printf("Enter value to delete: ");
                 if (scanf("%d", &value) == 1) {
                     root = deleteNode(root, value);
+                    logOperation(log, 'D', value);
                 } else {
                     printf("Error: Invalid integer.\n");
                     exit(1);
@@ -174,8 +334,76 @@ int main() {
                 }
                 break;
 
-            case 5: // Exit
+            case 5: // Bulk load: replaces the current tree
+                printf("Enter file name: ");
+                if (scanf("%255s", path) == 1) {
+                    FILE* fp = fopen(path, "r");
+                    if (!fp) {
+                        printf("Error: Cannot open %s.\n", path);
+                        break;
+                    }
+                    freeTree(root);
+                    root = bulkLoadStream(fp);
+                    fclose(fp);
+                    printf("Loaded %d value(s).\n", countNodes(root));
+                    // The log cannot express "replace the tree": checkpoint instead
+                    if (snapshotPath) checkpoint(root, snapshotPath, logPath, &log, &generation);
+                }
+                break;
+
+            case 6: // Batch insert
+                batch = readBatch(&count);
+                if (batch) {
+                    root = insertBatch(root, batch, count);
+                    for (int i = 0; i < count; i++) logOperation(log, 'I', batch[i]);
+                    free(batch);
+                }
+                break;
+
+            case 7: // Batch delete
+                batch = readBatch(&count);
+                if (batch) {
+                    root = deleteBatch(root, batch, count);
+                    for (int i = 0; i < count; i++) logOperation(log, 'D', batch[i]);
+                    free(batch);
+                }
+                break;
+
+            case 8: // Benchmark
+                printf("Enter number of keys: ");
+                if (scanf("%d", &value) == 1) {
+                    benchmarkBulkLoad(value);
+                } else {
+                    printf("Error: Invalid integer.\n");
+                    exit(1);
+                }
+                break;
+
+            case 9: // Concurrent benchmark (does not touch the menu tree)
+                printf("Enter number of keys: ");
+                if (scanf("%d", &value) == 1) {
+                    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+                    benchmarkConcurrent(value, cores > 1 ? (int)cores : 1);
+                } else {
+                    printf("Error: Invalid integer.\n");
+                    exit(1);
+                }
+                break;
+
+            case 10: // Save snapshot
+                if (!snapshotPath) {
+                    printf("Error: Persistence is off (start with a readable snapshot file).\n");
+                    break;
+                }
+                if (checkpoint(root, snapshotPath, logPath, &log, &generation)) {
+                    printf("Snapshot saved to %s.\n", snapshotPath);
+                }
+                break;
+
+            case 11: // Exit (logged changes survive without a final snapshot)
                 printf("Exiting...\n");
+                if (log) fclose(log);
+                freeTree(root);
                 exit(0);
 
             default:
@@ -0,0 +1,130 @@
+/*
+ * Stack Implementation (see stack.h)
+ * Error handling: allocation failures terminate the program,
+ * overflow/underflow are reported and leave the stack unchanged.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>   // for bool type
+#include "stack.h"
+#include "instrument.h"
+
+/* Function: createStack
+ * ----------------------
+ * Dynamically allocates memory for a stack with given capacity.
+ * Initializes top = -1 (empty).
+ */
+Stack* createStack(int capacity) {
+    Stack* s = (Stack*) malloc(sizeof(Stack));
+    if (!s) {
+        printf("Error: Memory allocation failed.\n");
+        exit(1);  // terminate safely if malloc fails
+    }
+
+    s->capacity = capacity;
+    s->top = -1;   // stack starts empty
+    s->arr = (int*) malloc(capacity * sizeof(int));
+
+    if (!s->arr) {
+        printf("Error: Memory allocation for stack array failed.\n");
+        free(s);   // free already allocated memory
+        exit(1);
+    }
+
+    return s;
+}
+
+/* Function: freeStack
+ * --------------------
+ * Releases the element array and the stack itself.
+ */
+void freeStack(Stack* s) {
+    if (!s) return;   // nothing to free
+    free(s->arr);
+    free(s);
+}
+
+/* Function: stackPush
+ * --------------------
+ * Adds an element on top of the stack without printing anything.
+ * Returns false if the stack is full (overflow).
+ */
+bool stackPush(Stack* s, int item) {
+    INSTR_SPAN_BEGIN(STACK_PUSH);
+    if (s->top == s->capacity - 1) {
+        INSTR_COUNT(STACK_OVERFLOWS, 1);
+        INSTR_SPAN_END(STACK_PUSH);
+        return false;
+    }
+    s->arr[++s->top] = item;   // increment top, then assign value
+    INSTR_SPAN_END(STACK_PUSH);
+    return true;
+}
+
+/* Function: stackPop
+ * -------------------
+ * Removes the top element into *item without printing anything.
+ * Returns false if the stack is empty (underflow); *item is untouched.
+ */
+bool stackPop(Stack* s, int* item) {
+    INSTR_SPAN_BEGIN(STACK_POP);
+    if (isEmpty(s)) {
+        INSTR_COUNT(STACK_UNDERFLOWS, 1);
+        INSTR_SPAN_END(STACK_POP);
+        return false;
+    }
+    *item = s->arr[s->top--];   // return current top, then decrement
+    INSTR_SPAN_END(STACK_POP);
+    return true;
+}
+
+/* Function: push
+ * ----------------
+ * Adds an element on top of the stack.
+ * If the stack is full, prints error (overflow).
+ */
+void push(Stack* s, int item) {
+    if (!stackPush(s, item)) {
+        printf("Error: Stack Overflow. Cannot push %d.\n", item);
+        return;
+    }
+    printf("Pushed %d onto stack.\n", item);
+}
+
+/* Function: pop
+ * --------------
+ * Removes and returns the top element of the stack.
+ * If the stack is empty, prints error (underflow).
+ */
+int pop(Stack* s) {
+    int item;
+    if (!stackPop(s, &item)) {
+        printf("Error: Stack Underflow. Cannot pop.\n");
+        return -1;   // sentinel value to indicate failure
+    }
+    return item;
+}
+
+/* Function: isEmpty
+ * ------------------
+ * Returns true if stack has no elements.
+ */
+bool isEmpty(Stack* s) {
+    return s->top == -1;
+}
+
+/* Function: display
+ * ------------------
+ * Prints all elements of the stack from top to bottom.
+ */
+void display(Stack* s) {
+    if (isEmpty(s)) {
+        printf("Stack is empty.\n");
+        return;
+    }
+    printf("Stack elements (top to bottom):\n");
+    for (int i = s->top; i >= 0; i--) {
+        printf("%d\n", s->arr[i]);
+    }
+}
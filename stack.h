@@ -0,0 +1,30 @@
+/*
+ * Stack (library part of prgm3.c)
+ * -------------------------------
+ * push()/pop() report errors and results to the user as before;
+ * stackPush()/stackPop() are the silent cores they are built on, for
+ * callers (such as the benchmark driver) that only need a status.
+ */
+#ifndef STACK_H
+#define STACK_H
+
+#include <stdbool.h>   // for bool type
+
+/* ----- STRUCTURE DEFINITION ----- */
+typedef struct {
+    int *arr;       // dynamically allocated array to hold stack elements
+    int top;        // index of the top element (-1 when empty)
+    int capacity;   // maximum number of elements
+} Stack;
+
+/* ----- FUNCTION DECLARATIONS ----- */
+Stack* createStack(int capacity);
+void freeStack(Stack* s);
+bool stackPush(Stack* s, int item);
+bool stackPop(Stack* s, int* item);
+void push(Stack* s, int item);
+int pop(Stack* s);
+bool isEmpty(Stack* s);
+void display(Stack* s);
+
+#endif /* STACK_H */
@@ -0,0 +1,30 @@
+/*
+ * Statistics kernels (see stats.h)
+ * Callers guarantee 1 <= count <= MAX_NUMBERS (checked in getInput()).
+ */
+#include <math.h>     // for sqrt()
+#include "stats.h"
+#include "instrument.h"
+
+/* Function: calculateMean */
+double calculateMean(int numbers[], int count) {
+    INSTR_SPAN_BEGIN(CALCULATE_MEAN);
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += numbers[i];
+    }
+    INSTR_SPAN_END(CALCULATE_MEAN);
+    return sum / count;
+}
+
+/* Function: calculateStdDev */
+double calculateStdDev(int numbers[], int count, double mean) {
+    INSTR_SPAN_BEGIN(CALCULATE_STDDEV);
+    double variance = 0.0;
+    for (int i = 0; i < count; i++) {
+        variance += pow(numbers[i] - mean, 2);
+    }
+    variance /= count;
+    INSTR_SPAN_END(CALCULATE_STDDEV);
+    return sqrt(variance);
+}
@@ -0,0 +1,16 @@
+/*
+ * Statistics kernels (library part of prgm2.c)
+ * --------------------------------------------
+ * Pure computations on an already validated array; input handling and
+ * bounds checking stay in prgm2.c.
+ */
+#ifndef STATS_H
+#define STATS_H
+
+#define MAX_NUMBERS 100   // prevent buffer overflow
+
+/* ----- FUNCTION DECLARATIONS ----- */
+double calculateMean(int numbers[], int count);
+double calculateStdDev(int numbers[], int count, double mean);
+
+#endif /* STATS_H */